@@ -0,0 +1,198 @@
+// Click hit test microbenchmark: TargetGrid::raycast against testing every
+// target, which is also the reference the grid's answers are checked against.
+// Targets fill the whole arena of Game with the shipped radius, rays leave the
+// default camera position into the arena. No OpenGL context is needed.
+//
+// build (Linux, from the repository root, one command line):
+//   g++ -std=c++20 -O2 -Iinc -I<glad>/include -I<glm> -I<magic_enum>
+//       bench/GridBench.cpp src/TargetGrid.cpp src/Sphere.cpp src/Shader.cpp src/RenderStats.cpp
+//       src/TargetPlacer.cpp src/Random.cpp <glad>/src/glad.c -ldl -o GridBench
+// run:
+//   ./GridBench [--targets 16,256,4096,10000] [--cell-sizes 1,2,4] [--rays 100000]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cmath>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "../inc/Shader.h"
+#include "../inc/Sphere.h"
+#include "../inc/TargetGrid.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // the same as Game
+    const glm::vec3 ARENA_MIN(0.0f);
+    const glm::vec3 ARENA_MAX(40.0f, 18.0f, 20.0f);
+    const glm::vec3 CAMERA_POS(20.0f, 1.0f, 18.0f);
+    const float TARGET_RADIUS = 0.3f;
+
+    // defeats dead code elimination of the results
+    volatile int sink = 0;
+
+    // every target, nearest hit only, lowest id on a tie
+    int raycastAll(std::vector<std::unique_ptr<Sphere>> &spheres, const glm::vec3 &origin, const glm::vec3 &direction, float &distance)
+    {
+        // normalized like TargetGrid::raycast does, grazing hits then agree to the last bit
+        glm::vec3 dir = glm::normalize(direction);
+        float nearest = INFINITY;
+        int nearestId = -1;
+        for (int i = 0; i < (int)spheres.size(); i++)
+        {
+            float t;
+            if (TargetGrid::intersectSphere(origin, dir, spheres[i]->getCenter(), spheres[i]->getRadius(), t) && t < nearest)
+            {
+                nearest = t;
+                nearestId = i;
+            }
+        }
+        if (nearestId >= 0) distance = nearest;
+        return nearestId;
+    }
+
+    template <class F>
+    double nanosecondsPer(const int &iterations, F f)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            f(i);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout << "usage: " << program << " [--targets 16,256,4096,10000] [--cell-sizes 1,2,4] [--rays 100000]" << std::endl;
+    }
+
+    // value must be a number as a whole, a typo keeps the default instead of ending the benchmark
+    template <class T, class F>
+    bool parseNumber(const char *program, const std::string_view &arg, const std::string &value, T &target, F parse)
+    {
+        try
+        {
+            std::size_t length = 0;
+            T parsed = parse(value, &length);
+            if (length != value.size()) throw std::invalid_argument(value);
+            target = parsed;
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(program);
+            return false;
+        }
+    }
+
+    // comma separated numbers, the list is kept as it was if any of them is not a number
+    template <class T, class F>
+    bool parseList(const char *program, const std::string_view &arg, const std::string &value, std::vector<T> &target, F parse)
+    {
+        std::vector<T> list;
+        size_t start = 0;
+        while (start < value.size())
+        {
+            size_t end = value.find(',', start);
+            if (end == std::string::npos) end = value.size();
+            T item;
+            if (!parseNumber(program, arg, value.substr(start, end - start), item, parse)) return false;
+            list.push_back(item);
+            start = end + 1;
+        }
+        target = list;
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<int> targetCounts = { 16, 256, 4096, 10000 };
+    std::vector<float> cellSizes = { 1.0f, 2.0f, 4.0f };
+    int rayCount = 100000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--rays") parseNumber(argv[0], arg, value, rayCount, [](const std::string &s, std::size_t *length) { return std::stoi(s, length); });
+        else if (arg == "--targets") parseList(argv[0], arg, value, targetCounts, [](const std::string &s, std::size_t *length) { return std::stoi(s, length); });
+        else if (arg == "--cell-sizes") parseList(argv[0], arg, value, cellSizes, [](const std::string &s, std::size_t *length) { return std::stof(s, length); });
+        else std::cout << "Unknown option: " << arg << std::endl;
+    }
+
+    // never initialized, and leaked since no context exists to delete its program
+    Shader *shader = new Shader("", "");
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::cout << std::left << std::setw(10) << "targets" << std::setw(10) << "method" << std::setw(8) << "cell"
+        << std::setw(14) << "raycast ns" << std::setw(14) << "update ns" << std::setw(10) << "hit %" << "mismatches" << std::endl;
+
+    for (const auto &targetCount : targetCounts)
+    {
+        std::vector<std::unique_ptr<Sphere>> spheres;
+        glm::vec3 span = ARENA_MAX - ARENA_MIN - 2.0f * TARGET_RADIUS;
+        for (int i = 0; i < targetCount; i++)
+        {
+            glm::vec3 center = ARENA_MIN + TARGET_RADIUS + glm::vec3(span.x * unit(random), span.y * unit(random), span.z * unit(random));
+            spheres.push_back(std::make_unique<Sphere>(center, TARGET_RADIUS, glm::vec3(1.0f), *shader));
+        }
+
+        // rays from the camera spread over the arena in front of it
+        std::vector<glm::vec3> rays(rayCount);
+        for (auto &ray : rays)
+        {
+            ray = glm::normalize(glm::vec3(unit(random) - 0.5f, 0.6f * unit(random), -1.0f));
+        }
+
+        std::vector<int> expected(rayCount);
+        int hits = 0;
+        double allRay = nanosecondsPer(rayCount, [&](const int &i) {
+            float distance;
+            expected[i] = raycastAll(spheres, CAMERA_POS, rays[i], distance);
+            hits += expected[i] >= 0;
+            sink = sink + expected[i];
+        });
+        std::cout << std::setw(10) << targetCount << std::setw(10) << "all" << std::setw(8) << "-"
+            << std::setw(14) << allRay << std::setw(14) << "-" << std::setw(10) << 100.0 * hits / rayCount << "-" << std::endl;
+
+        for (const auto &cellSize : cellSizes)
+        {
+            TargetGrid grid(ARENA_MIN, ARENA_MAX, cellSize);
+            for (auto &sphere : spheres)
+            {
+                grid.add(*sphere);
+            }
+            int mismatches = 0;
+            double gridRay = nanosecondsPer(rayCount, [&](const int &i) {
+                float distance;
+                int id = grid.raycast(CAMERA_POS, rays[i], distance);
+                mismatches += id != expected[i];
+                sink = sink + id;
+            });
+            // a hit target respawning, back where it was so the next cell size sees the same layout
+            double gridUpdate = nanosecondsPer(rayCount, [&](const int &i) {
+                int id = i % targetCount;
+                glm::vec3 center = spheres[id]->getCenter();
+                spheres[id]->move(center + glm::vec3(0.5f, 0.0f, 0.0f));
+                grid.update(id);
+                spheres[id]->move(center);
+                grid.update(id);
+            }) / 2;
+            std::cout << std::setw(10) << targetCount << std::setw(10) << "grid" << std::setw(8) << cellSize
+                << std::setw(14) << gridRay << std::setw(14) << gridUpdate << std::setw(10) << "-" << mismatches << std::endl;
+        }
+    }
+    return 0;
+}
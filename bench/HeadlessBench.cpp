@@ -0,0 +1,444 @@
+// Headless render benchmark: draws the main.cpp scene into an offscreen
+// framebuffer through EGL (Mesa llvmpipe works), for a fixed number of frames
+// per resolution / target count, and writes per-frame CPU time, GPU time and
+// draw calls as JSON.
+//
+// build (Linux, from the repository root, one command line):
+//   g++ -std=c++20 -O2 -Iinc -I<glad>/include -I<glm> -I<magic_enum> $(pkg-config --cflags freetype2)
+//       bench/HeadlessBench.cpp src/Shader.cpp src/Camera.cpp src/Sphere.cpp src/SphereBatch.cpp
+//       src/Cube.cpp src/Crosshair.cpp src/MyPrinter.cpp src/FrameData.cpp src/RenderStats.cpp
+//       src/TargetPlacer.cpp src/Random.cpp <glad>/src/glad.c -lEGL -lfreetype -ldl -o HeadlessBench
+// run (from the repository root so src/shader is found, one command line):
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./HeadlessBench --frames 300
+//       --resolutions 1280x720,1920x1080 --targets 3,200,1000 --out bench.json
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <glm/glm.hpp>
+
+#include "../inc/Shader.h"
+#include "../inc/Camera.h"
+#include "../inc/DirectLight.h"
+#include "../inc/Sphere.h"
+#include "../inc/SphereBatch.h"
+#include "../inc/Cube.h"
+#include "../inc/MyPrinter.h"
+#include "../inc/Crosshair.h"
+#include "../inc/FrameData.h"
+#include "../inc/RenderStats.h"
+
+// path
+const std::filesystem::path rootPath = std::filesystem::current_path();
+const std::filesystem::path shaderPath = rootPath / "src" / "shader";
+
+// scene, same as main.cpp
+const glm::vec3 CAMERA_POS_DEFAULT(20.0f, 1.0f, 18.0f);
+const glm::vec3 CAMERA_FRONT_DEFAULT(0.0f, 0.0f, -1.0f);
+const glm::vec4 BACKGROUND_COLOR(133 / 255.0f, 204 / 255.0f, 255 / 255.0f, 1.0f);
+const glm::vec3 wallColor(255 / 255.0, 229 / 255.0, 204 / 255.0);
+const glm::vec3 sphereColor(0 / 255.0, 255 / 255.0, 255 / 255.0);
+
+struct BenchConfig {
+    int frames = 300;
+    std::vector<glm::ivec2> resolutions = { glm::ivec2(1920, 1080) };
+    std::vector<int> targets = { 3 };
+    std::string fontPath = "/usr/share/fonts/truetype/dejavu/DejaVuSansMono.ttf";
+    std::string outPath = "bench.json";
+};
+
+struct FrameSample {
+    double cpuMs;
+    double gpuMs;
+    unsigned int drawCalls;
+    unsigned int triangles;
+};
+
+struct RunResult {
+    glm::ivec2 resolution;
+    int targets;
+    std::vector<FrameSample> samples;
+};
+
+BenchConfig parseArgs(int argc, char **argv);
+bool createContext(EGLDisplay &display, EGLContext &context);
+RunResult runScene(const BenchConfig &config, const glm::ivec2 &resolution, const int &targetCount);
+void writeJson(const BenchConfig &config, const std::vector<RunResult> &results, const std::string &renderer);
+
+int main(int argc, char **argv)
+{
+    BenchConfig config = parseArgs(argc, argv);
+
+    EGLDisplay display;
+    EGLContext context;
+    if (!createContext(display, context)) return -1;
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+    {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return -1;
+    }
+    std::string renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+    std::cout << "Renderer: " << renderer << std::endl;
+
+    std::vector<RunResult> results;
+    for (const auto &resolution : config.resolutions)
+    {
+        for (const auto &targetCount : config.targets)
+        {
+            std::cout << "Running " << resolution.x << "x" << resolution.y << ", " << targetCount << " targets" << std::endl;
+            results.push_back(runScene(config, resolution, targetCount));
+        }
+    }
+    writeJson(config, results, renderer);
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    return 0;
+}
+
+namespace {
+    void printUsage(const char *program)
+    {
+        std::cout << "usage: " << program << " [--frames 300] [--resolutions 1920x1080,...] [--targets 3,...] [--font FILE] [--out FILE]" << std::endl;
+    }
+
+    // value must be a number as a whole, a typo keeps the default instead of ending the benchmark
+    bool parseInt(const char *program, const std::string_view &arg, const std::string &value, int &target)
+    {
+        try
+        {
+            std::size_t length = 0;
+            int parsed = std::stoi(value, &length);
+            if (length != value.size()) throw std::invalid_argument(value);
+            target = parsed;
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(program);
+            return false;
+        }
+    }
+
+    // WIDTHxHEIGHT
+    bool parseResolution(const char *program, const std::string_view &arg, const std::string &value, glm::ivec2 &target)
+    {
+        size_t x = value.find('x');
+        if (x == std::string::npos)
+        {
+            std::cout << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(program);
+            return false;
+        }
+        glm::ivec2 parsed;
+        if (!parseInt(program, arg, value.substr(0, x), parsed.x) || !parseInt(program, arg, value.substr(x + 1), parsed.y)) return false;
+        target = parsed;
+        return true;
+    }
+
+    std::vector<std::string> split(std::string_view list)
+    {
+        std::vector<std::string> items;
+        size_t start = 0;
+        while (start <= list.size())
+        {
+            size_t end = list.find(',', start);
+            if (end == std::string_view::npos) end = list.size();
+            if (end > start) items.emplace_back(list.substr(start, end - start));
+            start = end + 1;
+        }
+        return items;
+    }
+}
+
+// a list with any malformed item is kept as it was
+BenchConfig parseArgs(int argc, char **argv)
+{
+    BenchConfig config;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view arg = argv[i];
+        std::string_view value = argv[i + 1];
+        if (arg == "--frames") parseInt(argv[0], arg, std::string(value), config.frames);
+        else if (arg == "--font") config.fontPath = value;
+        else if (arg == "--out") config.outPath = value;
+        else if (arg == "--targets")
+        {
+            std::vector<int> targets;
+            bool valid = true;
+            for (const auto &item : split(value))
+            {
+                int count;
+                valid = valid && parseInt(argv[0], arg, item, count);
+                if (valid) targets.push_back(count);
+            }
+            if (valid) config.targets = targets;
+        }
+        else if (arg == "--resolutions")
+        {
+            std::vector<glm::ivec2> resolutions;
+            bool valid = true;
+            for (const auto &item : split(value))
+            {
+                glm::ivec2 resolution;
+                valid = valid && parseResolution(argv[0], arg, item, resolution);
+                if (valid) resolutions.push_back(resolution);
+            }
+            if (valid) config.resolutions = resolutions;
+        }
+        else std::cout << "Unknown option: " << arg << std::endl;
+    }
+    return config;
+}
+
+// OpenGL 3.3 core context without any window or surface
+bool createContext(EGLDisplay &display, EGLContext &context)
+{
+    display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    if (getPlatformDisplay != nullptr)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+#endif
+    if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+    {
+        std::cout << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig eglConfig;
+    EGLint configCount = 0;
+    eglChooseConfig(display, configAttribs, &eglConfig, 1, &configCount);
+    eglBindAPI(EGL_OPENGL_API);
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, configCount > 0 ? eglConfig : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        std::cout << "Failed to create the EGL OpenGL 3.3 core context" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+RunResult runScene(const BenchConfig &config, const glm::ivec2 &resolution, const int &targetCount)
+{
+    RunResult result;
+    result.resolution = resolution;
+    result.targets = targetCount;
+    result.samples.reserve(config.frames);
+
+    // offscreen framebuffer
+    GLuint FBO, colorBuffer, depthBuffer;
+    glGenFramebuffers(1, &FBO);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, resolution.x, resolution.y);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, resolution.x, resolution.y);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "Offscreen framebuffer is not complete" << std::endl;
+    glViewport(0, 0, resolution.x, resolution.y);
+    glEnable(GL_DEPTH_TEST);
+
+    Camera camera(CAMERA_POS_DEFAULT, CAMERA_FRONT_DEFAULT);
+    camera.setAspect((float)resolution.x / resolution.y);
+    DirectLight directLight(glm::vec3(-2, -3, -3), glm::vec3(0.3f), glm::vec3(0.4f), glm::vec3(0.1f));
+
+    {
+        Shader sphereShader((shaderPath / "sphere_instanced.vert").string(), (shaderPath / "triangle.frag").string());
+        sphereShader.init();
+        Shader triangleShader((shaderPath / "triangle.vert").string(), (shaderPath / "triangle.frag").string());
+        triangleShader.init();
+        Shader textShader((shaderPath / "character.vert").string(), (shaderPath / "character.frag").string());
+        textShader.init();
+        Shader crosshairShader((shaderPath / "crosshair.vert").string(), (shaderPath / "crosshair.frag").string());
+        crosshairShader.init();
+
+        FrameData frameData(camera, directLight);
+        frameData.init();
+
+        // targets on a wall-sized grid in front of the camera
+        const float radius = targetCount > 25 ? 0.3f : 1.0f;
+        const int columns = std::max(1, (int)std::ceil(std::sqrt(targetCount * 2.0)));
+        const int rows = std::max(1, (targetCount + columns - 1) / columns);
+        std::vector<std::unique_ptr<Sphere>> spheres;
+        SphereBatch sphereBatch(sphereShader, 64);
+        sphereBatch.init();
+        for (int i = 0; i < targetCount; i++)
+        {
+            glm::vec3 center(1.0f + 38.0f * (i % columns + 0.5f) / columns, 1.0f + 16.0f * (i / columns + 0.5f) / rows, 1.0f);
+            spheres.push_back(std::make_unique<Sphere>(center, radius, sphereColor, triangleShader, 64));
+            sphereBatch.add(*spheres.back());
+        }
+
+        Cube cubes[] = {
+        Cube(glm::vec3(0.0f), 40.0f, 0.01f, 20.0f, wallColor * 1.2f, triangleShader), // floor
+        Cube(glm::vec3(0.0f), 40.0f, 18.0f, 0.01f, wallColor, triangleShader), // back wall
+        Cube(glm::vec3(0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader), // left wall
+        Cube(glm::vec3(40.0f, 0.0f, 0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader), // right wall
+        };
+
+        Crosshair crosshair(crosshairShader, 10.0, glm::vec3(1.0f, 0.0f, 0.0f), resolution.x, resolution.y);
+        crosshair.init();
+
+        // HUD only when a font is available
+        std::unique_ptr<MyPrinter> printer;
+        int frameText = -1, targetText = -1;
+        if (std::filesystem::exists(config.fontPath))
+        {
+            printer = std::make_unique<MyPrinter>(config.fontPath, textShader, resolution.x, resolution.y);
+            frameText = printer->createText(10.0f, resolution.y - 40.0f, 0.5f, glm::vec3(0.0f));
+            targetText = printer->createText(10.0f, resolution.y - 60.0f, 0.5f, glm::vec3(0.0f));
+        }
+        else std::cout << "Font " << config.fontPath << " not found, HUD skipped" << std::endl;
+
+        GLuint timerQuery;
+        glGenQueries(1, &timerQuery);
+        glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, BACKGROUND_COLOR.w);
+
+        for (int frame = 0; frame < config.frames; frame++)
+        {
+            auto cpuStart = std::chrono::steady_clock::now();
+            glBeginQuery(GL_TIME_ELAPSED, timerQuery);
+
+            // scripted aim: sweep across the wall and move one target per frame
+            camera.persMove(12.0f * std::sin(frame * 0.05f), 4.0f * std::cos(frame * 0.07f));
+            if (targetCount > 0)
+            {
+                Sphere &moved = *spheres[frame % targetCount];
+                moved.move(moved.getCenter());
+            }
+
+            RenderStats::reset();
+            frameData.update();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            sphereBatch.renderSpheres();
+            for (auto &cube : cubes)
+            {
+                cube.renderCube();
+            }
+            crosshair.renderCrosshair();
+            if (printer)
+            {
+                printer->setText(frameText, "Frame       : {:d}", frame);
+                printer->setText(targetText, "Targets     : {:d}", targetCount);
+                printer->renderTexts();
+            }
+
+            glEndQuery(GL_TIME_ELAPSED);
+            auto cpuEnd = std::chrono::steady_clock::now();
+
+            // waits for the frame, so the next one starts from an idle GPU
+            GLuint64 gpuTime = 0;
+            glGetQueryObjectui64v(timerQuery, GL_QUERY_RESULT, &gpuTime);
+
+            FrameSample sample;
+            sample.cpuMs = std::chrono::duration<double, std::milli>(cpuEnd - cpuStart).count();
+            sample.gpuMs = gpuTime / 1.0e6;
+            sample.drawCalls = RenderStats::drawCalls;
+            sample.triangles = RenderStats::triangles;
+            result.samples.push_back(sample);
+        }
+        glDeleteQueries(1, &timerQuery);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &FBO);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+    return result;
+}
+
+namespace {
+    double percentile(std::vector<double> values, const double &p)
+    {
+        if (values.empty()) return 0;
+        size_t index = std::min(values.size() - 1, (size_t)(p * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    double mean(const std::vector<double> &values)
+    {
+        double sum = 0;
+        for (const auto &value : values) sum += value;
+        return values.empty() ? 0 : sum / values.size();
+    }
+
+    template <class T, class F>
+    void writeArray(std::ofstream &out, const std::vector<T> &samples, F field)
+    {
+        out << "[";
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            out << (i ? "," : "") << field(samples[i]);
+        }
+        out << "]";
+    }
+}
+
+void writeJson(const BenchConfig &config, const std::vector<RunResult> &results, const std::string &renderer)
+{
+    std::ofstream out(config.outPath);
+    out << "{\n  \"renderer\": \"" << renderer << "\",\n  \"frames\": " << config.frames << ",\n  \"runs\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const RunResult &run = results[i];
+        std::vector<double> cpu, gpu;
+        for (const auto &sample : run.samples)
+        {
+            cpu.push_back(sample.cpuMs);
+            gpu.push_back(sample.gpuMs);
+        }
+        out << "    {\n"
+            << "      \"width\": " << run.resolution.x << ", \"height\": " << run.resolution.y << ", \"targets\": " << run.targets << ",\n"
+            << "      \"summary\": { \"cpu_ms_mean\": " << mean(cpu) << ", \"cpu_ms_p99\": " << percentile(cpu, 0.99)
+            << ", \"gpu_ms_mean\": " << mean(gpu) << ", \"gpu_ms_p99\": " << percentile(gpu, 0.99)
+            << ", \"draw_calls\": " << (run.samples.empty() ? 0 : run.samples.back().drawCalls) << " },\n"
+            << "      \"cpu_ms\": ";
+        writeArray(out, run.samples, [](const FrameSample &s) { return s.cpuMs; });
+        out << ",\n      \"gpu_ms\": ";
+        writeArray(out, run.samples, [](const FrameSample &s) { return s.gpuMs; });
+        out << ",\n      \"draw_calls\": ";
+        writeArray(out, run.samples, [](const FrameSample &s) { return s.drawCalls; });
+        out << ",\n      \"triangles\": ";
+        writeArray(out, run.samples, [](const FrameSample &s) { return s.triangles; });
+        out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    std::cout << "Results written to " << config.outPath << std::endl;
+}
\ No newline at end of file
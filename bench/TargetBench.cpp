@@ -0,0 +1,212 @@
+// Target hit test / motion microbenchmark: the per-Sphere loop main.cpp used
+// before TargetGrid, against TargetStore (structure of arrays) at every SIMD level.
+// No OpenGL context is needed, the spheres are never drawn.
+//
+// build (Linux, from the repository root, one command line):
+//   g++ -std=c++20 -O2 -Iinc -I<glad>/include -I<glm> -I<magic_enum>
+//       bench/TargetBench.cpp src/TargetStore.cpp src/Sphere.cpp src/Shader.cpp src/RenderStats.cpp
+//       src/TargetPlacer.cpp src/Random.cpp <glad>/src/glad.c -ldl -o TargetBench
+// run:
+//   ./TargetBench [--targets 16,256,4096,10000] [--rays 100000]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cmath>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "../inc/Shader.h"
+#include "../inc/Sphere.h"
+#include "../inc/TargetStore.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // defeats dead code elimination of the results
+    volatile int sink = 0;
+
+    // the loop over Sphere objects, nearest hit only
+    int raycastSpheres(std::vector<std::unique_ptr<Sphere>> &spheres, const glm::vec3 &origin, const glm::vec3 &direction, float &distance)
+    {
+        float nearest = INFINITY;
+        int nearestId = -1;
+        for (int i = 0; i < (int)spheres.size(); i++)
+        {
+            glm::vec3 c = spheres[i]->getCenter() - origin;
+            float d = glm::dot(c, direction);
+            float h_2 = glm::dot(c, c) - d * d;
+            float r = spheres[i]->getRadius();
+            if (d <= 0 || h_2 >= r * r) continue;
+            float t = d - std::sqrt(r * r - h_2);
+            if (t < nearest)
+            {
+                nearest = t;
+                nearestId = i;
+            }
+        }
+        if (nearestId >= 0) distance = nearest;
+        return nearestId;
+    }
+
+    template <class F>
+    double nanosecondsPer(const int &iterations, F f)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            f(i);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout << "usage: " << program << " [--targets 16,256,4096,10000] [--rays 100000]" << std::endl;
+    }
+
+    // value must be a number as a whole, a typo keeps the default instead of ending the benchmark
+    template <class T, class F>
+    bool parseNumber(const char *program, const std::string_view &arg, const std::string &value, T &target, F parse)
+    {
+        try
+        {
+            std::size_t length = 0;
+            T parsed = parse(value, &length);
+            if (length != value.size()) throw std::invalid_argument(value);
+            target = parsed;
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(program);
+            return false;
+        }
+    }
+
+    // comma separated numbers, the list is kept as it was if any of them is not a number
+    template <class T, class F>
+    bool parseList(const char *program, const std::string_view &arg, const std::string &value, std::vector<T> &target, F parse)
+    {
+        std::vector<T> list;
+        size_t start = 0;
+        while (start < value.size())
+        {
+            size_t end = value.find(',', start);
+            if (end == std::string::npos) end = value.size();
+            T item;
+            if (!parseNumber(program, arg, value.substr(start, end - start), item, parse)) return false;
+            list.push_back(item);
+            start = end + 1;
+        }
+        target = list;
+        return true;
+    }
+
+    const char *levelName(const TargetStore::SimdLevel &level)
+    {
+        switch (level)
+        {
+        case TargetStore::SimdLevel::AVX: return "soa avx";
+        case TargetStore::SimdLevel::SSE: return "soa sse";
+        default: return "soa scalar";
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<int> targetCounts = { 16, 256, 4096, 10000 };
+    int rayCount = 100000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string_view arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--rays") parseNumber(argv[0], arg, value, rayCount, [](const std::string &s, std::size_t *length) { return std::stoi(s, length); });
+        else if (arg == "--targets") parseList(argv[0], arg, value, targetCounts, [](const std::string &s, std::size_t *length) { return std::stoi(s, length); });
+        else std::cout << "Unknown option: " << arg << std::endl;
+    }
+
+    // never initialized, and leaked since no context exists to delete its program
+    Shader *shader = new Shader("", "");
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::cout << "best simd level: " << levelName(TargetStore::detectSimdLevel()) << std::endl;
+    std::cout << std::left << std::setw(10) << "targets" << std::setw(14) << "method"
+        << std::setw(16) << "raycast ns" << std::setw(16) << "integrate ns" << "mismatches" << std::endl;
+
+    for (const auto &targetCount : targetCounts)
+    {
+        std::vector<std::unique_ptr<Sphere>> spheres;
+        std::vector<glm::vec3> velocities;
+        std::vector<glm::vec3> spawns;
+        TargetStore store;
+        for (int i = 0; i < targetCount; i++)
+        {
+            glm::vec3 center(1.0f + 38.0f * unit(random), 1.0f + 16.0f * unit(random), 1.0f + 5.0f * unit(random));
+            glm::vec3 velocity(unit(random) - 0.5f, unit(random) - 0.5f, 0.0f);
+            spheres.push_back(std::make_unique<Sphere>(center, 0.3f, glm::vec3(1.0f), *shader));
+            velocities.push_back(velocity);
+            spawns.push_back(center);
+            store.add(center, 0.3f, velocity);
+        }
+
+        // rays from around the spawn point towards the wall
+        std::vector<glm::vec3> rays(rayCount);
+        for (auto &ray : rays)
+        {
+            ray = glm::normalize(glm::vec3(unit(random) - 0.5f, 0.5f * (unit(random) - 0.5f), -1.0f));
+        }
+        const glm::vec3 origin(20.0f, 8.0f, 18.0f);
+        const float deltaTime = 1.0f / 1000;
+        int integrations = std::max(1, 10000000 / targetCount);
+
+        std::vector<int> expected(rayCount);
+        double sphereRay = nanosecondsPer(rayCount, [&](const int &i) {
+            float distance;
+            expected[i] = raycastSpheres(spheres, origin, rays[i], distance);
+            sink = sink + expected[i];
+        });
+        double sphereMove = nanosecondsPer(integrations, [&](const int &) {
+            for (int s = 0; s < targetCount; s++)
+            {
+                spheres[s]->move(spheres[s]->getCenter() + velocities[s] * deltaTime);
+            }
+        });
+        std::cout << std::setw(10) << targetCount << std::setw(14) << "sphere loop"
+            << std::setw(16) << sphereRay << std::setw(16) << sphereMove << "-" << std::endl;
+
+        for (auto level : { TargetStore::SimdLevel::SCALAR, TargetStore::SimdLevel::SSE, TargetStore::SimdLevel::AVX })
+        {
+            store.setSimdLevel(level);
+            if (store.getSimdLevel() != level) continue; // not supported here
+            int mismatches = 0;
+            double storeRay = nanosecondsPer(rayCount, [&](const int &i) {
+                float distance;
+                int id = store.raycast(origin, rays[i], distance);
+                mismatches += id != expected[i];
+                sink = sink + id;
+            });
+            double storeMove = nanosecondsPer(integrations, [&](const int &) {
+                store.integrate(deltaTime);
+            });
+            std::cout << std::setw(10) << targetCount << std::setw(14) << levelName(level)
+                << std::setw(16) << storeRay << std::setw(16) << storeMove << mismatches << std::endl;
+            // back to the spawn positions for the next level
+            for (int s = 0; s < targetCount; s++)
+            {
+                store.setCenter(s, spawns[s]);
+            }
+        }
+    }
+    return 0;
+}
\ No newline at end of file
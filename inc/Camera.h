@@ -10,14 +10,16 @@ class Camera
 private:
     // camera attributes
     glm::vec3 position;
-    glm::vec3 front;
-    glm::vec3 frontHorizontal;
-    glm::vec3 up;
-    glm::vec3 right;
     glm::vec3 worldUp;
-    // euler angles
-    float yaw;
-    float pitch;
+    // derived from yaw and pitch, rebuilt lazily on the next read
+    mutable glm::vec3 front;
+    mutable glm::vec3 frontHorizontal;
+    mutable glm::vec3 up;
+    mutable glm::vec3 right;
+    mutable bool orientationChanged;
+    // euler angles, accumulated in double so many small mouse deltas do not drift
+    double yaw;
+    double pitch;
     // camera options
     float movementSpeed;
     float mouseSens; // mouse sensitivity
@@ -25,6 +27,10 @@ private:
     float aspect;
     float near;
     float far;
+    // rebuilt only when the camera changes
+    mutable glm::mat4 viewMatrix;
+    mutable bool viewChanged;
+    glm::mat4 persMatrix;
 
 public:
     // default camera args
@@ -47,11 +53,18 @@ public:
     void setAspect(const float &aspect);
     glm::vec3 getPosition() const;
     glm::vec3 getFront() const;
+    double getYaw() const;
+    double getPitch() const;
+    // front vector of an arbitrary orientation, e.g. the one at a past input event
+    static glm::vec3 frontFromAngles(const double &yaw, const double &pitch);
     glm::mat4 getViewMatrix() const;
     glm::mat4 getPersMatrix() const;
     void bodyMove(const Movement &direction, const float &deltaTime);
     void persMove(float xOffset, float yOffset);
+    // take over a pose computed elsewhere, e.g. published by the game thread
+    void setPose(const glm::vec3 &position, const double &yaw, const double &pitch);
 
 private:
-    void updateCameraArgs();
+    void updateCameraArgs() const;
+    void updatePersMatrix();
 };
\ No newline at end of file
@@ -8,8 +8,6 @@
 #include <glm/gtx/string_cast.hpp>
 
 #include "Shader.h"
-#include "Camera.h"
-#include "DirectLight.h"
 
 class Cube
 {
@@ -27,12 +25,16 @@ private:
     GLuint VBO;
     GLuint VAO;
 
-    const Camera &camera;
-    const DirectLight &directLight;
+    // uniform handles of shader, resolved once
+    struct Uniforms {
+        UniformHandle model, shininess, color;
+    } uniforms;
+
     void initVertice();
+    void initUniforms();
     void setMatrix();
 public:
-    Cube(const glm::vec3 &position, const float &length_x, const float &length_y, const float &length_z, const glm::vec3 &color, const Shader &shader, const Camera &camera, const DirectLight &directLight);
+    Cube(const glm::vec3 &position, const float &length_x, const float &length_y, const float &length_z, const glm::vec3 &color, const Shader &shader);
     ~Cube();
     void renderCube();
 };
\ No newline at end of file
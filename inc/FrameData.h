@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Camera.h"
+#include "DirectLight.h"
+
+// per-frame camera and light state, shared by every program declaring
+// the std140 uniform block "FrameData" (bound to FRAME_DATA_BINDING)
+class FrameData
+{
+private:
+    // std140 layout, vec3s are padded to vec4
+    struct Block {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 cameraPos;
+        glm::vec4 lightDirection;
+        glm::vec4 lightAmbient;
+        glm::vec4 lightDiffuse;
+        glm::vec4 lightSpecular;
+    };
+
+    Block block;
+    GLuint UBO;
+
+    const Camera &camera;
+    const DirectLight &directLight;
+
+public:
+    FrameData(const Camera &camera, const DirectLight &directLight);
+    ~FrameData();
+    void init();
+    void update();
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "InputEvent.h"
+
+// when the render loop starts the next frame. capped frames wait on the
+// monotonic clock, sleeping most of the way and spinning the rest, since a
+// plain sleep overshoots by up to a scheduler tick. with vsync the wait
+// after a swap delays input sampling so the camera is latched just before
+// the frame is rendered instead of a whole refresh earlier. with the game on
+// its own thread the latch holds because the render loop then waits for the
+// snapshot that handled the sampled input, see Game::waitForInputs()
+class FramePacer
+{
+public:
+    enum class Mode {
+        UNCAPPED,   // no swap interval, no wait
+        CAPPED,     // no swap interval, frames start every 1 / fpsCap
+        VSYNC       // swap interval 1, input sampled jitWait after the swap returns
+    };
+
+private:
+    static const Timestamp SPIN_MARGIN; // sleeps end this much before the deadline
+
+    Mode mode;
+    Timestamp framePeriod; // CAPPED
+    Timestamp jitWait;     // VSYNC
+    Timestamp nextFrame;
+    Timestamp lastPresent;
+
+public:
+    FramePacer(const Mode &mode, const float &fpsCap, const float &jitWaitMs);
+    ~FramePacer();
+    // sets the swap interval of the current context, refreshRate bounds the vsync wait
+    void init(const int &refreshRate);
+    // before the frame's input is sampled
+    void waitForFrame();
+    // right after the swap
+    void framePresented(const Timestamp &time = nowMicros());
+    Mode getMode() const;
+
+    // sleep and spin until deadline
+    static void waitUntil(const Timestamp &deadline);
+};
\ No newline at end of file
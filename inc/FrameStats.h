@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#include "InputEvent.h"
+#include "Histogram.h"
+
+// frame pacing statistics: timestamps of presented frames go into a lock-free
+// ring, frame times into a histogram over a sliding window and one over the
+// whole session. "1% low" is the fps of the 99th percentile frame time.
+class FrameStats
+{
+public:
+    static const int RING_SIZE = 1 << 14; // power of two, more than the window holds at a few thousand fps
+
+    struct Summary {
+        std::int64_t frames;
+        double averageFps;
+        double low1Fps;
+        double low01Fps;
+        double maxFrameMs;
+    };
+
+private:
+    // written by the render thread only, readable from any thread through recentFrames()
+    std::atomic<Timestamp> ring[RING_SIZE];
+    std::atomic<std::uint64_t> writeIndex; // frames added so far
+
+    std::uint64_t windowStart; // oldest frame still in the window
+    Timestamp windowLength;
+    Histogram windowHistogram;
+    Histogram sessionHistogram;
+    Timestamp sessionStart;
+
+    Timestamp frameAt(const std::uint64_t &index) const;
+    static Summary summarize(const Histogram &histogram, const Timestamp &duration);
+
+public:
+    FrameStats(const double &windowSeconds = 5.0);
+    // call once per frame, right after the buffers are swapped
+    void addFrame(const Timestamp &time = nowMicros());
+    Summary window() const;
+    Summary session() const;
+    // copies up to maxCount of the latest timestamps, oldest first, returns how many
+    int recentFrames(Timestamp *out, const int &maxCount) const;
+    // session summary and frame time histogram, csv
+    bool save(const std::string &path) const;
+};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "InputEvent.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include "Options.h"
+#include "Camera.h"
+#include "Sphere.h"
+#include "TargetGrid.h"
+#include "TargetPlacer.h"
+#include "Simulation.h"
+#include "PickingBuffer.h"
+#include "RawMouse.h"
+#include "SessionRecorder.h"
+#include "SessionLog.h"
+#include "TargetMetrics.h"
+
+// camera, targets and scoring. update() replays the input in timestamp order
+// and publishes a snapshot; it runs on its own 1 kHz thread, or from the render
+// loop in single threaded mode. the render side only ever reads snapshots, so a
+// slow frame does not delay hit registration
+class Game
+{
+public:
+    static const int TARGET_ID_BASE = 1; // picking id of target 0
+
+    // everything the render thread needs from one update
+    struct Snapshot {
+        Timestamp time;
+        glm::vec3 cameraPosition;
+        double yaw;
+        double pitch;
+        std::vector<glm::vec3> targetCenters; // sized once by start(), one per target
+        int hitTimes;
+        int clickTimes;
+        Timestamp reactionTimeTotal; // spawn to hit, microseconds
+        Timestamp lastClickTime;     // latest left press, 0 before the first
+        TargetMetrics::Summary metrics;
+        std::uint64_t inputSequence; // window inputs handled so far
+        std::uint64_t rawSequence;   // raw mouse events handled so far
+    };
+
+private:
+    Camera camera;
+    std::vector<std::unique_ptr<Sphere>> targets; // logic only, never drawn
+    TargetGrid targetGrid;
+    TargetPlacer targetPlacer;
+    Simulation simulation;
+    bool tracking;
+    bool gpuPicking;
+    const Shader &targetShader;
+
+    int hitTimes;
+    int clickTimes;
+    Timestamp reactionTimeTotal;
+    Timestamp lastClickTime;
+    TargetMetrics metrics;
+    bool moving[6];        // movement keys held, by Camera::Movement
+    Timestamp movedUntil;  // body movement applied up to here
+    Timestamp updateTime;  // of the update running now, snapshots from then on show its changes
+    std::vector<Timestamp> shownSince; // per target, first snapshot time showing where it is now
+    std::uint64_t inputsHandled; // game side
+    std::uint64_t rawHandled;    // game side
+    std::uint64_t inputsPushed;  // render thread side
+
+    // window thread -> game
+    SpscQueue<InputEvent, 4096> inputs;
+    SpscQueue<PickingBuffer::Result, 256> pickResults;
+    // game -> render thread
+    SpscQueue<Timestamp, 256> pickRequests;
+    // game thread only: view direction of each click waiting for its pick
+    struct PendingClick {
+        Timestamp time;
+        glm::vec3 front;
+    };
+    SpscQueue<PendingClick, 512> pendingClicks;
+    TripleBuffer<Snapshot> snapshots;
+    RawMouse *rawMouse;
+    SessionRecorder *recorder;
+    glm::vec3 recordedPosition; // camera pose of the last CAMERA record
+    double recordedYaw;
+    double recordedPitch;
+
+    std::thread thread;
+    std::atomic<bool> running;
+    // publish() wakes a render thread waiting in waitForInputs()
+    std::mutex publishMutex;
+    std::condition_variable published;
+    std::uint64_t publishCount; // guarded by publishMutex
+
+    void run();
+    void advanceTo(const Timestamp &time);
+    void handleInputEvent(const InputEvent &event);
+    void handlePick(const PickingBuffer::Result &pick);
+    int aimedTarget(float &distance);
+    void updateAim(const Timestamp &time);
+    void hitJudgement(const Timestamp &clickTime);
+    glm::vec3 clickFront(const Timestamp &clickTime);
+    void targetHit(const int &target, const Timestamp &clickTime, const glm::vec3 &front);
+    void publish(const Timestamp &time);
+
+public:
+    Game(const Options &options, const std::uint64_t &seed, const Camera &camera, const Shader &targetShader);
+    ~Game();
+    // before start(), -1 when every spawn cell but the spare one is taken
+    int addTarget(const float &radius, const Timestamp &spawnTime = nowMicros());
+    // events are read from rawMouse as well when it is set
+    void setRawMouse(RawMouse *rawMouse);
+    // everything the game handles and decides is recorded while set
+    void setRecorder(SessionRecorder *recorder);
+    SessionLog::Header sessionHeader(const std::uint64_t &seed, const float &targetRadius) const;
+    // runs a recorded session through the game again, on a game that was
+    // created from its header and not started. prints the score and
+    // whether it matches the recording, false if it does not
+    bool replay(SessionReader &reader);
+    // with ownThread the game updates itself every STEP, otherwise call update() once per frame
+    void start(const Timestamp &time, const bool &ownThread);
+    void stop();
+    void update(const Timestamp &now);
+
+    // render thread side
+    bool pushInput(const InputEvent &event);
+    bool popPickRequest(Timestamp &clickTime);
+    bool pushPickResult(const PickingBuffer::Result &result);
+    // false if nothing was published since the last call
+    bool updateSnapshot();
+    // takes the latest snapshot, and with input still queued for the game
+    // thread waits for the one that handled it. false if none did within timeout
+    bool waitForInputs(const Timestamp &timeout);
+    const Snapshot &snapshot() const;
+};
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// HDR style histogram of non-negative integers (e.g. microseconds): values below
+// 2^SUB_BUCKET_BITS are exact, larger ones fall into log2 buckets split into
+// 2^(SUB_BUCKET_BITS - 1) linear sub buckets, so the relative error stays under 2^-(SUB_BUCKET_BITS - 1)
+class Histogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int MAX_BITS = 36; // values are clamped below 2^36, about 19 hours in microseconds
+
+private:
+    std::vector<std::uint32_t> counts;
+    std::int64_t totalCount;
+    std::int64_t sum;
+    std::int64_t maxValue;
+
+    static int indexOf(std::int64_t value);
+    static std::int64_t valueOf(const int &index); // middle of the bucket
+
+public:
+    Histogram();
+    void record(std::int64_t value);
+    // for sliding windows, value must have been recorded before
+    void remove(std::int64_t value);
+    void reset();
+    // merge the values recorded in other
+    void add(const Histogram &other);
+
+    std::int64_t count() const;
+    double mean() const;
+    // largest recorded value, exact until a value is removed, then the bucket bound
+    std::int64_t max() const;
+    // smallest value that percentile (0 ~ 1) of the recorded values are at or below
+    std::int64_t valueAtPercentile(const double &percentile) const;
+    // calls f(value, count) for every non-empty bucket in ascending order
+    template <class F>
+    void forEachBucket(F f) const
+    {
+        for (int i = 0; i < (int)counts.size(); i++)
+        {
+            if (counts[i] > 0) f(valueOf(i), counts[i]);
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+// microseconds on a monotonic clock
+using Timestamp = std::int64_t;
+
+inline Timestamp nowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// mouse and movement key input in arrival order, replayed by the game
+struct InputEvent {
+    enum class Type : std::uint8_t {
+        MOUSE_MOVE, MOUSE_BUTTON, KEY
+    };
+    Type type;
+    Timestamp time;
+    // MOUSE_MOVE: cursor offset since the previous event
+    float xOffset;
+    float yOffset;
+    // MOUSE_BUTTON, and KEY with button holding a Camera::Movement
+    int button;
+    int action;
+};
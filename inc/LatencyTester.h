@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "InputEvent.h"
+#include "Histogram.h"
+
+// click to photon test: a click flips the marker quad in the corner between
+// black and white in the first frame rendered after it, and the time from the
+// click to that frame's swap is recorded. with useFence the render thread also
+// waits for a fence behind the swap, for when the GPU finished the frame.
+// a photodiode on the marker measures the rest of the way to the screen
+class LatencyTester
+{
+private:
+    static const float MARKER_SIZE; // pixels
+
+    const Shader &shader;
+    unsigned int screenWidth;
+    unsigned int screenHeight;
+    bool useFence;
+    float vertices[8];
+
+    GLuint VBO;
+    GLuint VAO;
+    UniformHandle colorUniform;
+
+    bool markerWhite;
+    Timestamp lastClickTime; // latest click seen
+    Timestamp pendingClick;  // click shown in the current frame, 0 if none
+
+    Histogram swapLatency;
+    Histogram gpuLatency;
+
+public:
+    LatencyTester(const Shader &shader, const unsigned int &screenWidth, const unsigned int &screenHeight, const bool &useFence);
+    ~LatencyTester();
+    void init();
+    // before rendering, with the time of the latest click, new or not
+    void click(const Timestamp &clickTime);
+    void renderMarker();
+    // right after the swap returned
+    void framePresented(const Timestamp &time = nowMicros());
+
+    const Histogram &getSwapLatency() const;
+    const Histogram &getGpuLatency() const;
+    bool save(const std::string &path) const;
+};
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <format>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -14,23 +16,65 @@
 #include "Shader.h"
 
 struct Character {
-    GLuint     textureID;  // 字形纹理的ID
     glm::ivec2 size;       // 字形大小
     glm::ivec2 bearing;    // 从基准线到字形左部/顶部的偏移值
     GLuint     advance;    // 原点距下一个字形原点的距离
+    glm::vec2  uvMin;      // 字形在图集中的左上角纹理坐标
+    glm::vec2  uvMax;      // 字形在图集中的右下角纹理坐标
 };
 
 class MyPrinter
 {
 private:
-    std::map<GLchar, Character> Characters;
+    // text kept between frames, laid out again only when its string changes
+    struct TextElement {
+        GLfloat x, y, scale;
+        glm::vec3 color;
+        std::string text;   // reserved to capacity once, never reallocated
+        int capacity;       // max characters
+        int firstFloat;     // offset of its quads in retainedVertices
+        bool dirty;
+    };
+
+    static const int GLYPH_COUNT = 128;
+    static const int ATLAS_WIDTH = 1024;
+    static const int FLOATS_PER_VERTEX = 7; // vec2 pos, vec2 tex, vec3 color
+
+    Character Characters[GLYPH_COUNT];
+    GLuint atlasTexture;
     GLuint VAO, VBO;
+    int bufferCapacity; // floats the VBO can hold
+    std::vector<GLfloat> batch; // vertices of the text added since beginText()
+
+    std::vector<TextElement> elements;
+    std::vector<GLfloat> retainedVertices; // capacity * 6 vertices per element, unused glyphs are degenerate
+    GLuint retainedVAO, retainedVBO;
+    int retainedCapacity; // floats the retained VBO can hold
     unsigned int screenWidth;
     unsigned int screenHeight;
     const Shader &textShader;
 public:
     MyPrinter(const std::string &fontPath, const Shader &textShader, const unsigned int &screenWidth, const unsigned int &screenHeight);
     ~MyPrinter();
-    void renderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color);
+    // batched api: all the text added between beginText() and flush() is drawn with one call
+    void beginText();
+    void addText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color);
+    void flush();
+    void renderText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color);
+    // retained api: create once, setText() every frame, one draw call for all elements
+    int createText(GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color, const int &capacity = 64);
+    void setText(const int &id, std::string_view text);
+    // format into a stack buffer, no allocation per frame
+    template <class... Args>
+    void setText(const int &id, std::format_string<Args...> fmt, Args &&...args)
+    {
+        char buffer[256];
+        auto result = std::format_to_n(buffer, sizeof(buffer), fmt, std::forward<Args>(args)...);
+        setText(id, std::string_view(buffer, result.out - buffer));
+    }
+    void renderTexts();
+private:
+    void initVertexArray(const GLuint &vao, const GLuint &vbo);
+    int layoutText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color, GLfloat *out) const;
 };
 
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+// command line options
+struct Options {
+    enum class InputMode {
+        GLFW,       // cursor callbacks, polled once per frame
+        RAW_THREAD, // raw mouse on a dedicated input thread
+    };
+
+    enum class GameMode {
+        STATIC,     // targets only move when they are hit
+        TRACKING    // targets strafe, stepped by the fixed rate simulation
+    };
+
+    enum class HitMode {
+        RAY,        // analytic ray against the target spheres
+        GPU_PICKING // object id under the crosshair, works for any target shape
+    };
+
+    enum class Threading {
+        SINGLE,     // the game is updated by the render loop once per frame
+        SPLIT       // the game runs on its own 1 kHz thread
+    };
+
+    enum class PresentMode {
+        UNCAPPED,   // swap as fast as possible
+        CAPPED,     // precise frame rate cap
+        VSYNC       // vsync, input sampled late in the refresh
+    };
+
+    InputMode inputMode = InputMode::GLFW;
+    GameMode gameMode = GameMode::STATIC;
+    HitMode hitMode = HitMode::RAY;
+    Threading threading = Threading::SPLIT;
+    PresentMode presentMode = PresentMode::UNCAPPED;
+    float fpsCap = 240.0f;
+    float jitWaitMs = 0.0f; // VSYNC: wait after the swap before input is sampled
+    bool hasSeed = false;
+    std::uint64_t seed = 0; // target placement, random per session unless given
+    std::string profileOutPath; // profiler samples are written here on exit when set
+    std::string statsOutPath; // frame time statistics of the session are written here on exit when set
+    bool latencyTest = false;  // click to photon marker and latency histograms
+    bool latencyFence = false; // also wait for the GPU to finish each measured frame
+    std::string latencyOutPath = "latency.csv";
+    std::string recordPath; // every input and its outcome are recorded here when set
+    std::string replayPath; // score a recorded session instead of playing
+    bool watchShaders = false; // reload shaders when their files change
+    std::string shaderCachePath = "shader_cache"; // linked programs of earlier launches, empty to always compile
+};
+
+Options parseOptions(int argc, char **argv);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "InputEvent.h"
+
+// offscreen target pass with an extra R32UI attachment holding the object id
+// of every pixel. a click copies the id under the crosshair into a pixel buffer
+// object and the result is picked up a frame or two later, so nothing waits on the GPU
+class PickingBuffer
+{
+public:
+    struct Result {
+        unsigned int objectId; // 0 when nothing pickable was under the crosshair
+        Timestamp clickTime;
+        Timestamp frameTime;   // snapshot time of the frame the id was read from
+    };
+
+private:
+    static const int MAX_PENDING = 8; // readbacks in flight
+
+    struct PendingPick {
+        GLuint PBO;
+        GLsync fence;
+        Timestamp clickTime;
+        Timestamp frameTime;
+    };
+
+    GLuint FBO;
+    GLuint colorBuffer, idBuffer, depthBuffer;
+    unsigned int width;
+    unsigned int height;
+
+    std::vector<Timestamp> requested; // clicks waiting for the next target pass
+    PendingPick pending[MAX_PENDING]; // ring, oldest at pendingHead
+    int pendingHead;
+    int pendingCount;
+
+public:
+    PickingBuffer();
+    ~PickingBuffer();
+    void init(const unsigned int &width, const unsigned int &height);
+    // render the targets after this, clears color, ids and depth
+    void bind(const glm::vec4 &clearColor);
+    // any time, the pick happens after the next target pass
+    void requestPick(const Timestamp &clickTime);
+    // after the target pass: start the readback of the crosshair pixel for every requested click,
+    // frameTime is the snapshot time the pass was drawn from
+    void readPicks(const Timestamp &frameTime);
+    // copy the color to the default framebuffer and draw there from now on
+    void present();
+    // finished picks in click order, false when none is ready yet
+    bool poll(Result &result);
+};
\ No newline at end of file
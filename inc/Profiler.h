@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "MyPrinter.h"
+
+// named CPU scopes paired with GL_TIME_ELAPSED queries, plus an overlay with
+// the per-section times, frame time percentiles and a frame time graph.
+// sections must not nest (one GL_TIME_ELAPSED query can be active at a time)
+// and each one is timed at most once per frame
+class Profiler
+{
+public:
+    static const int MAX_SECTIONS = 8;
+    static const int HISTORY = 240;         // frames kept for the overlay
+    static const int QUERY_BUFFERS = 4;     // query sets in flight, read QUERY_BUFFERS frames later
+    static const int MAX_RECORDED = 1 << 20; // frames kept for dump()
+
+    // times a section for as long as it lives
+    class Scope
+    {
+    private:
+        Profiler &profiler;
+        int section;
+    public:
+        Scope(Profiler &profiler, const int &section);
+        ~Scope();
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Section {
+        std::string name;
+        int textId;
+        Clock::time_point cpuStart;
+    };
+
+    struct FrameRecord {
+        float frameMs;
+        float cpuMs[MAX_SECTIONS];
+        float gpuMs[MAX_SECTIONS]; // negative until the query result is read
+    };
+
+    std::vector<Section> sections;
+    GLuint queries[QUERY_BUFFERS][MAX_SECTIONS];
+    long long queryFrame[QUERY_BUFFERS][MAX_SECTIONS]; // frame the query was issued in, -1 when its result was read
+    bool querying; // the section being timed has a query running
+
+    long long frameIndex;
+    Clock::time_point lastFrameEnd;
+    FrameRecord current;
+    FrameRecord history[HISTORY];
+    std::vector<FrameRecord> recorded;
+    long long recordStart; // frame of recorded[0]
+    bool recording;
+
+    // overlay
+    bool visible;
+    Clock::time_point lastOverlayUpdate;
+    int frameText;
+    int drawCallText;
+    MyPrinter &printer;
+    const Shader &lineShader;
+    unsigned int screenWidth;
+    unsigned int screenHeight;
+    GLfloat graphVertices[(HISTORY + 2) * 2]; // frame time line strip, then the budget line
+    GLuint VBO, VAO;
+    UniformHandle colorUniform;
+
+    void resolveQueries(const int &buffer);
+    void storeGpuTime(const long long &frame, const int &section, const float &ms);
+    void updateOverlay();
+    void clearOverlay();
+    void renderGraph();
+
+public:
+    Profiler(const Shader &lineShader, MyPrinter &printer, const unsigned int &screenWidth, const unsigned int &screenHeight);
+    ~Profiler();
+    void init();
+    int addSection(const std::string &name);
+    void beginFrame();
+    void endFrame();
+    void begin(const int &section);
+    void end(const int &section);
+    void setVisible(const bool &visible);
+    bool isVisible() const;
+    // overlay graph, its text is drawn with the printer's retained texts
+    void renderOverlay();
+    // keep every frame from now on, so dump() can write them out
+    void startRecording();
+    bool dump(const std::string &path) const;
+};
\ No newline at end of file
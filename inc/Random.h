@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// xoshiro256** seeded through splitmix64: fast, and the same seed gives the
+// same sequence on every platform, unlike rand()
+class Random
+{
+private:
+    std::uint64_t state[4];
+
+public:
+    Random(const std::uint64_t &seed = 0);
+    void seed(const std::uint64_t &seed);
+    std::uint64_t next();
+    // uniform in [0, bound), bound > 0
+    std::uint32_t below(const std::uint32_t &bound);
+    // uniform in [0, 1)
+    float nextFloat();
+
+    // a seed from std::random_device, for sessions that do not ask for one
+    static std::uint64_t randomSeed();
+};
\ No newline at end of file
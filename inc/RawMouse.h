@@ -0,0 +1,41 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#include "InputEvent.h"
+#include "SpscQueue.h"
+
+// collects raw mouse motion and buttons on its own thread, independent of
+// the render loop: evdev on Linux, Raw Input on Windows
+class RawMouse
+{
+private:
+    SpscQueue<InputEvent, 8192> events;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::uint64_t dropped; // input thread only, reported by stop()
+    std::atomic<std::uint64_t> queued; // events pushed so far
+#ifdef _WIN32
+    std::atomic<unsigned long> threadId;
+#else
+    int fd; // evdev device
+#endif
+
+    void run();
+    void push(const InputEvent &event);
+    void reportDropped();
+
+public:
+    RawMouse();
+    ~RawMouse();
+    // false if raw input is not available, the caller should fall back to GLFW
+    bool start();
+    void stop();
+    // consumer side, the game
+    bool pop(InputEvent &event);
+    bool peek(InputEvent &event) const;
+    // any thread, events queued since start
+    std::uint64_t queuedCount() const;
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// GL work submitted since the last reset(), for the HUD and the benchmark
+struct RenderStats {
+    static unsigned int drawCalls;
+    static unsigned int triangles;
+    static void reset();
+    static void addDraw(const unsigned int &triangleCount);
+};
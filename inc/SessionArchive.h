@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "SessionLog.h"
+
+// many sessions in one file, laid out to be used straight from a read-only
+// mapping: a fixed size Header, then the event columns of every session,
+// then the session index. each column is a plain array starting on an
+// ALIGNMENT boundary, so it can be read in place without parsing or copying
+namespace SessionArchive {
+    const std::uint32_t MAGIC = 0x4153314A; // "J1SA"
+    const std::uint16_t VERSION = 1;
+    const std::size_t ALIGNMENT = 64;
+    const std::size_t PLAYER_NAME_SIZE = 32;
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t reserved;
+        std::uint32_t sessionCount;
+        std::uint32_t reserved2;
+        std::uint64_t indexOffset;  // sessionCount SessionEntry
+        std::uint64_t fileSize;
+        std::uint8_t padding[32];
+    };
+    static_assert(sizeof(Header) == 64, "archive header must stay 64 bytes");
+
+    struct SessionEntry {
+        char player[PLAYER_NAME_SIZE]; // zero padded
+        std::uint64_t seed;
+        std::int64_t startTime;     // microseconds, the game clock start
+        std::int64_t endTime;       // last record
+        std::uint8_t gameMode;      // Options::GameMode
+        std::uint8_t hitMode;       // Options::HitMode
+        std::uint16_t reserved;
+        std::uint32_t clickCount;
+        std::uint32_t hitCount;
+        std::uint32_t reserved2;
+        // column offsets from the start of the archive
+        std::uint64_t clickTimeOffset;  // int64[clickCount], relative to startTime
+        std::uint64_t clickHitOffset;   // uint8[clickCount], 1 for a hit
+        std::uint64_t killTimeOffset;   // int64[hitCount], spawn to hit
+        std::uint64_t flickOffset;      // float[hitCount], degrees the view turned from spawn to hit
+    };
+    static_assert(sizeof(SessionEntry) == 104, "session entry layout changed");
+}
+
+// collects sessions and writes them as one archive
+class ArchiveWriter
+{
+private:
+    struct Session {
+        SessionArchive::SessionEntry entry;
+        std::vector<std::int64_t> clickTimes;
+        std::vector<std::uint8_t> clickHits;
+        std::vector<std::int64_t> killTimes;
+        std::vector<float> flicks;
+    };
+    std::vector<Session> sessions;
+
+public:
+    // reads a recorded session to the end, false if it has no START record
+    bool addSession(const std::string &player, SessionReader &reader);
+    int sessionCount() const;
+    bool write(const std::string &path) const;
+};
+
+// read-only mapping of an archive
+class MappedArchive
+{
+private:
+    const char *data;
+    std::size_t size;
+#ifdef _WIN32
+    void *file;
+    void *mapping;
+#else
+    int fd;
+#endif
+
+    bool validate(const std::string &path) const;
+
+public:
+    MappedArchive();
+    ~MappedArchive();
+    MappedArchive(const MappedArchive &) = delete;
+    MappedArchive &operator=(const MappedArchive &) = delete;
+    bool open(const std::string &path);
+    void close();
+
+    const SessionArchive::Header &getHeader() const;
+    int sessionCount() const;
+    const SessionArchive::SessionEntry &getSession(const int &i) const;
+    // the column at offset, see SessionEntry for the types
+    template <class T>
+    const T *column(const std::uint64_t &offset) const
+    {
+        return reinterpret_cast<const T *>(data + offset);
+    }
+};
\ No newline at end of file
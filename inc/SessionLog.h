@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// file format of a recorded session: a Header, then records of a one byte
+// RecordType followed by that type's packed payload, little endian.
+// INPUT, PICK, UPDATE and START are what a replay needs, the rest is the outcome
+// the game computed from them, kept for analysis and to verify replays
+namespace SessionLog {
+    const std::uint32_t MAGIC = 0x4C53314A; // "J1SL"
+    const std::uint16_t VERSION = 4;
+
+    enum class RecordType : std::uint8_t {
+        START = 1,  // the game clock started
+        INPUT,      // an InputEvent as the game handled it
+        PICK,       // object id read back for a click in gpu picking mode
+        CAMERA,     // camera pose after an update that changed it
+        SPAWN,      // target moved to a placer cell
+        HIT,
+        MISS,
+        UPDATE      // tracking mode: the simulation was stepped up to an update
+    };
+
+#pragma pack(push, 1)
+    struct Header {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint8_t gameMode;  // Options::GameMode
+        std::uint8_t hitMode;   // Options::HitMode
+        std::uint64_t seed;
+        float targetRadius;
+        float cameraPosition[3];
+        double cameraYaw;
+        double cameraPitch;
+    };
+
+    struct Start {
+        std::int64_t time;
+    };
+
+    struct Input {
+        std::int64_t time;
+        std::uint8_t type; // InputEvent::Type
+        float xOffset;
+        float yOffset;
+        std::int16_t button;
+        std::int8_t action;
+    };
+
+    struct Pick {
+        std::int64_t time;        // of the click
+        std::int64_t frameTime;   // snapshot time of the frame the id was read from
+        std::int64_t handledTime; // update the result was handled in
+        std::uint32_t objectId;
+    };
+
+    struct Camera {
+        std::int64_t time;
+        float position[3];
+        float yaw;
+        float pitch;
+    };
+
+    struct Spawn {
+        std::int64_t time;
+        std::uint32_t target;
+        std::int32_t cell;
+    };
+
+    struct Hit {
+        std::int64_t time;
+        std::uint32_t target;
+        std::int64_t reactionTime; // spawn to hit, microseconds
+    };
+
+    struct Miss {
+        std::int64_t time;
+    };
+
+    struct Update {
+        std::int64_t time;
+    };
+#pragma pack(pop)
+
+    // bytes following the type byte, 0 for an unknown type
+    inline std::size_t payloadSize(const RecordType &type)
+    {
+        switch (type)
+        {
+        case RecordType::START: return sizeof(Start);
+        case RecordType::INPUT: return sizeof(Input);
+        case RecordType::PICK: return sizeof(Pick);
+        case RecordType::CAMERA: return sizeof(Camera);
+        case RecordType::SPAWN: return sizeof(Spawn);
+        case RecordType::HIT: return sizeof(Hit);
+        case RecordType::MISS: return sizeof(Miss);
+        case RecordType::UPDATE: return sizeof(Update);
+        }
+        return 0;
+    }
+
+    const std::size_t MAX_PAYLOAD_SIZE = std::max({ sizeof(Input), sizeof(Pick), sizeof(Camera) });
+}
+
+// sequential reader of a session file
+class SessionReader
+{
+private:
+    std::vector<char> data;
+    SessionLog::Header header;
+    std::size_t offset;
+
+public:
+    SessionReader();
+    // false if the file can't be read or is not a session of this version
+    bool open(const std::string &path);
+    const SessionLog::Header &getHeader() const;
+    // false at the end or on a truncated or unknown record
+    bool next(SessionLog::RecordType &type, const char *&payload);
+    void rewind();
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "SessionLog.h"
+#include "SpscQueue.h"
+#include "InputEvent.h"
+
+// appends session records to a file. the game thread only pushes into a
+// queue, a writer thread drains it to disk, so a slow disk never stalls
+// an update. records are dropped, and counted, if the writer falls behind
+class SessionRecorder
+{
+private:
+    struct Entry {
+        SessionLog::RecordType type;
+        char payload[SessionLog::MAX_PAYLOAD_SIZE];
+    };
+
+    SpscQueue<Entry, 1 << 14> entries;
+    std::ofstream out;
+    std::thread writer;
+    std::atomic<bool> running;
+    std::uint64_t dropped; // producer only
+
+    void run();
+    void drain();
+    template <class T>
+    void push(const SessionLog::RecordType &type, const T &record);
+
+public:
+    SessionRecorder();
+    ~SessionRecorder();
+    bool open(const std::string &path, const SessionLog::Header &header);
+    // writes what is still queued and closes the file
+    void close();
+    bool isOpen() const;
+
+    // producer side, the game
+    void recordStart(const Timestamp &time);
+    void recordInput(const InputEvent &event);
+    void recordPick(const Timestamp &clickTime, const Timestamp &frameTime, const Timestamp &handledTime, const std::uint32_t &objectId);
+    void recordCamera(const Timestamp &time, const glm::vec3 &position, const double &yaw, const double &pitch);
+    void recordSpawn(const Timestamp &time, const int &target, const int &cell);
+    void recordHit(const Timestamp &time, const int &target, const Timestamp &reactionTime);
+    void recordMiss(const Timestamp &time);
+    void recordUpdate(const Timestamp &time);
+};
\ No newline at end of file
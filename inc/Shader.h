@@ -3,6 +3,10 @@
 #include <glad/glad.h>
 
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -12,6 +16,14 @@
 #include <glm/gtc/type_ptr.hpp>
 
 constexpr auto LONG_LINE = "---------------------------------------------------\n";
+// binding point of the "FrameData" uniform block, see FrameData.h
+constexpr GLuint FRAME_DATA_BINDING = 0;
+
+// resolved once by Shader::uniform(), setting through it needs no name lookup
+struct UniformHandle {
+    int slot = -1;
+};
+
 class Shader
 {
 public:
@@ -27,7 +39,15 @@ public:
     bool hasInit;
     Shader(const std::string &vertexPath, const std::string &fragmentPath);
     ~Shader();
+    // linked programs are saved to directory and loaded from there on later
+    // launches, as long as the sources and the driver are the same. needs the
+    // current context, does nothing without program binary support (GL 4.1 or
+    // ARB_get_program_binary)
+    static void enableProgramCache(const std::string &directory, GLADloadproc load);
     void init();
+    // reads and links the files again, the new program replaces the old one only if it links.
+    // uniform values and handles carry over
+    bool reload();
     void use() const;
     void setBool(const std::string &name, const bool &value) const;
     void setInt(const std::string &name, const int &value) const;
@@ -41,6 +61,38 @@ public:
     void setVec4(const std::string &name, const glm::vec4 &vec) const;
     void setVec4(const std::string &name, const float &x, const float &y, const float &z, const float &w = 0.0f) const;
     void setMat4(const std::string &name, const glm::mat4 &matrix) const;
+
+    // handle api for the hot paths
+    UniformHandle uniform(const std::string &name) const;
+    void setBool(const UniformHandle &handle, const bool &value) const;
+    void setInt(const UniformHandle &handle, const int &value) const;
+    void setFloat(const UniformHandle &handle, const float &value) const;
+    void setVec3(const UniformHandle &handle, const glm::vec3 &vec) const;
+    void setVec4(const UniformHandle &handle, const glm::vec4 &vec) const;
+    void setMat4(const UniformHandle &handle, const glm::mat4 &matrix) const;
 private:
-    void checkCompileErrors(unsigned int shader, CompileType type);
+    // active uniforms of the linked program, name -> location
+    std::unordered_map<std::string, GLint> uniformLocations;
+    // locations handed out by uniform(), indexed by UniformHandle::slot
+    mutable std::vector<GLint> handleLocations;
+    mutable std::unordered_map<std::string, int> handleSlots;
+    // unknown names already reported
+    mutable std::unordered_set<std::string> warnedNames;
+
+    // empty when the cache is off
+    static std::string programCacheDirectory;
+    static std::uint64_t driverHash;
+
+    static bool readSource(const std::string &path, std::string &code);
+    static std::uint64_t fnv1a(const std::string &data, std::uint64_t hash);
+    std::string programCachePath(const std::string &vertexCode_s, const std::string &fragmentCode_s) const;
+    bool loadCachedProgram(const std::string &cachePath, GLuint &program) const;
+    void storeCachedProgram(const std::string &cachePath, const GLuint &program) const;
+    static void bindFrameData(const GLuint &program);
+    GLuint buildProgram(const std::string &vertexCode_s, const std::string &fragmentCode_s, bool &linked);
+    void copyUniforms(const GLuint &from, const GLuint &to);
+    bool checkCompileErrors(unsigned int shader, CompileType type);
+    void loadUniformLocations();
+    GLint getLocation(const std::string &name) const;
+    GLint handleLocation(const UniformHandle &handle) const;
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+#include "Shader.h"
+#include "InputEvent.h"
+
+// notices edits to the shader files on its own thread: inotify on Linux,
+// modification times polled elsewhere. programs have to be linked on the
+// thread that owns the context, so the render loop calls reloadChanged(),
+// which reloads the programs using a file that changed
+class ShaderWatcher
+{
+private:
+    static const Timestamp SETTLE_TIME; // editors write a file in several steps
+
+    std::string directory;
+    std::vector<Shader *> shaders;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::mutex mutex;
+    std::map<std::string, Timestamp> changed; // file name -> last change, guarded by mutex
+#ifdef __linux__
+    int fd; // inotify
+#endif
+
+    void run();
+    void markChanged(const std::string &fileName);
+
+public:
+    ShaderWatcher(const std::string &directory);
+    ~ShaderWatcher();
+    void add(Shader &shader);
+    bool start();
+    void stop();
+    // render thread, returns the number of programs reloaded
+    int reloadChanged();
+};
\ No newline at end of file
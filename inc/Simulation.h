@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "InputEvent.h"
+#include "TargetStore.h"
+#include "Random.h"
+
+// tracking targets advanced in fixed 1 ms steps, independent of the frame rate.
+// each target strafes at a random velocity that changes every STRAFE_MIN ~ STRAFE_MAX
+// seconds and bounces off the movement bounds; rendering interpolates between the
+// last two steps, hit tests use the stepped state at the click time
+class Simulation
+{
+public:
+    static const Timestamp STEP = 1000; // microseconds, 1 kHz
+
+private:
+    TargetStore targets;             // state at time
+    std::vector<glm::vec3> previous; // state at time - STEP
+    std::vector<float> strafeTimer;  // seconds until the next velocity change
+    Random random;
+
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
+    float minSpeed;
+    float maxSpeed;
+    Timestamp time;
+    bool started;
+
+    void step();
+    void pickVelocity(const int &id);
+
+public:
+    Simulation(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const float &minSpeed, const float &maxSpeed);
+    void seed(const std::uint64_t &seed);
+    int addTarget(const glm::vec3 &center, const float &radius);
+    int size() const;
+    // the first step happens STEP after startTime
+    void start(const Timestamp &startTime);
+    // run every step up to time, never past it
+    void advanceTo(const Timestamp &time);
+    Timestamp getTime() const;
+    // put a target at center with a new velocity, no interpolation from the old place
+    void respawn(const int &id, const glm::vec3 &center);
+    glm::vec3 getCenter(const int &id) const;
+    // position for a frame shown at renderTime, one step behind the simulation
+    glm::vec3 getDisplayPosition(const int &id, const Timestamp &renderTime) const;
+    int raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+};
\ No newline at end of file
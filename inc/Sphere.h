@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <map>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -8,13 +9,26 @@
 #include <glm/gtx/string_cast.hpp>
 
 #include "Shader.h"
-#include "Camera.h"
-#include "DirectLight.h"
+#include "InputEvent.h"
+#include "TargetPlacer.h"
 
 
 class Sphere
 {
+public:
+    // unit sphere mesh shared by every sphere of the same smoothness
+    struct Mesh {
+        GLuint VBO;
+        GLuint VAO;
+        int vertexCount;
+        int users;
+    };
+    static Mesh *acquireMesh(const int &smoothness);
+    static void releaseMesh(const int &smoothness);
+
 private:
+    static std::map<int, Mesh> meshes;
+
     // sphere info
     glm::vec3   center;
     float       radius;
@@ -22,26 +36,38 @@ private:
     float       shineness;
 
     int posInGrid;
+    Timestamp spawnTime; // when it was put at posInGrid
 
     const Shader &shader;
-    std::vector<float> vertices;// vertex.x, y, z, normal.x, y, z
+    Mesh *mesh;
     int smoothness;
+    glm::mat4 model; // translate(center) * scale(radius)
+    bool changed; // moved since the last clearChanged()
 
-    GLuint VBO;
-    GLuint VAO;
+    // uniform handles of shader, resolved once
+    struct Uniforms {
+        UniformHandle model, shininess, color;
+    } uniforms;
 
-    const Camera &camera;
-    const DirectLight &directLight;
+    static void buildUnitSphere(std::vector<float> &vertices, const int &smoothness);
+    void updateModel();
+    void initUniforms();
     void setMatrix();
     //void renderTriangle(const glm::vec3 &vertex_0, const glm::vec3 &vertex_1, const glm::vec3 &vertex_2);
 public:
-    Sphere(const glm::vec3 &center, const float &radius, const glm::vec3 &color, const Shader &shader, const Camera &camera, const DirectLight &directLight, const int &smoothness = 16);
+    Sphere(const glm::vec3 &center, const float &radius, const glm::vec3 &color, const Shader &shader, const int &smoothness = 16);
     ~Sphere();
     void init();
     void renderSphere();
     void move(const glm::vec3 &nextCenter);
     glm::vec3 getCenter();
     float getRadius();
-    void setGridPos();
+    glm::vec3 getColor();
+    bool hasChanged() const;
+    void clearChanged();
+    Timestamp getSpawnTime();
+    int getGridPos();
+    // move to a free cell of placer and give back the old one, false when no cell is free
+    bool setGridPos(TargetPlacer &placer, const Timestamp &spawnTime = nowMicros());
 };
 
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "Sphere.h"
+
+// draw many spheres of the same smoothness with one instanced draw call
+class SphereBatch
+{
+private:
+    // per-instance attributes, location 2 ~ 4 of sphere_instanced.vert
+    struct Instance {
+        glm::vec3 center;
+        float     radius;
+        glm::vec3 color;
+    };
+
+    std::vector<Sphere *> spheres;
+    std::vector<Instance> instances;
+    int capacity; // instances the instance VBO can hold
+    int smoothness;
+    float shineness;
+    int objectIdBase; // picking id of the first sphere
+
+    const Shader &shader;
+    Sphere::Mesh *mesh;
+
+    GLuint instanceVBO;
+    GLuint VAO;
+
+    // uniform handles of shader, resolved once
+    struct Uniforms {
+        UniformHandle shininess, objectIdBase;
+    } uniforms;
+
+    void initUniforms();
+    void setMatrix();
+    void updateInstances();
+
+public:
+    SphereBatch(const Shader &shader, const int &smoothness = 16);
+    ~SphereBatch();
+    void init();
+    int add(Sphere &sphere);
+    int size() const;
+    // sphere i is written as objectIdBase + i to the picking attachment
+    void setObjectIdBase(const int &objectIdBase);
+    void renderSpheres();
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// lock-free single producer / single consumer ring buffer,
+// Capacity must be a power of two
+template <class T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+private:
+    std::array<T, Capacity> buffer;
+    alignas(64) std::atomic<std::size_t> head{ 0 }; // next slot to read, owned by the consumer
+    alignas(64) std::atomic<std::size_t> tail{ 0 }; // next slot to write, owned by the producer
+
+public:
+    // producer side, false when the queue is full
+    bool push(const T &value)
+    {
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) return false;
+        buffer[currentTail & (Capacity - 1)] = value;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, false when the queue is empty
+    bool pop(T &value)
+    {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) return false;
+        value = buffer[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, the oldest value without removing it, false when the queue is empty
+    bool peek(T &value) const
+    {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) return false;
+        value = buffer[currentHead & (Capacity - 1)];
+        return true;
+    }
+
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "InputEvent.h"
+#include "Histogram.h"
+
+// streaming mean and variance (Welford), O(1) per value
+class RunningStats
+{
+private:
+    std::int64_t count;
+    double mean;
+    double m2; // sum of squared differences from the mean
+
+public:
+    RunningStats();
+    void add(const double &value);
+    std::int64_t getCount() const;
+    double getMean() const;
+    double variance() const;
+    double stdDev() const;
+};
+
+// per target metrics, updated as events happen: spawn to hit time, the angle
+// the view turned from spawn to hit, how often the crosshair left the target
+// again before the hit (overshoots and corrections) and how long it was on it.
+// each event is O(1), percentiles come from a histogram and are only read
+// again after a hit, so nothing here costs anything per frame
+class TargetMetrics
+{
+public:
+    struct Summary {
+        std::int64_t hits;
+        double reactionMeanMs;
+        double reactionStdDevMs;
+        double reactionP50Ms;
+        double reactionP90Ms;
+        double flickMeanDeg;
+        double overshootMean;
+        double timeOnTargetMeanMs;
+    };
+
+private:
+    struct TargetState {
+        Timestamp spawnTime;
+        glm::vec3 spawnFront;    // view direction when it spawned
+        int overshoots;
+        Timestamp onTargetSince; // while aimed at
+        Timestamp timeOnTarget;
+    };
+
+    std::vector<TargetState> targets;
+    int aimedTarget; // under the crosshair, -1 for none
+
+    Histogram reactionTimes;
+    RunningStats reaction;
+    RunningStats flick;
+    RunningStats overshoot;
+    RunningStats timeOnTarget;
+    Summary summary;
+
+public:
+    TargetMetrics();
+    void spawn(const int &target, const Timestamp &time, const glm::vec3 &front);
+    // the target under the crosshair changed, or not, -1 for none
+    void aim(const int &target, const Timestamp &time);
+    void hit(const int &target, const Timestamp &time, const glm::vec3 &front);
+    const Summary &getSummary() const;
+};
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Random.h"
+
+// spawn cells on a columns x rows x layers grid. occupancy is a bitset and the
+// free cells are kept in a list with swap-remove, so acquire() and release() are O(1)
+// whatever the fill, and a seeded generator places targets the same way every session
+class TargetPlacer
+{
+private:
+    glm::ivec3 cellCount;       // columns, rows, layers
+    glm::vec3 origin;           // center of cell 0
+    glm::vec3 spacing;          // between cell centers
+    std::vector<std::uint64_t> occupied;
+    std::vector<int> freeCells;
+    std::vector<int> freeSlot;  // index of each cell in freeCells, -1 when occupied
+    Random random;
+
+public:
+    TargetPlacer(const glm::ivec3 &cellCount, const glm::vec3 &origin, const glm::vec3 &spacing, const std::uint64_t &seed = 0);
+    void seed(const std::uint64_t &seed);
+    // a random free cell, now occupied, -1 when the grid is full
+    int acquire();
+    void release(const int &cell);
+    bool isOccupied(const int &cell) const;
+    int freeCount() const;
+    int cellTotal() const;
+    glm::vec3 cellCenter(const int &cell) const;
+};
\ No newline at end of file
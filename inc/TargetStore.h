@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// hot target state as structure of arrays, so hit tests and motion updates
+// stream through contiguous floats, 4 (SSE) or 8 (AVX) targets at a time.
+// arrays are padded to a multiple of LANES with dead targets, no tail loops needed
+class TargetStore
+{
+public:
+    enum class SimdLevel {
+        SCALAR,
+        SSE,    // SSE2, 4 targets per instruction
+        AVX,    // 8 targets per instruction
+    };
+    static const int LANES = 8;
+
+private:
+    std::vector<float> x, y, z;
+    std::vector<float> radius;
+    std::vector<float> vx, vy, vz;
+    std::vector<std::int32_t> alive; // -1 alive, 0 dead or padding, loads straight into a SIMD mask
+    int count;
+    SimdLevel simdLevel;
+
+    int raycastScalar(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+    int raycastSSE(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+    int raycastAVX(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+    void integrateScalar(const float &deltaTime);
+    void integrateSSE(const float &deltaTime);
+    void integrateAVX(const float &deltaTime);
+
+public:
+    TargetStore();
+    int add(const glm::vec3 &center, const float &radius, const glm::vec3 &velocity = glm::vec3(0.0f));
+    int size() const;
+    glm::vec3 getCenter(const int &id) const;
+    float getRadius(const int &id) const;
+    glm::vec3 getVelocity(const int &id) const;
+    bool isAlive(const int &id) const;
+    void setCenter(const int &id, const glm::vec3 &center);
+    void setVelocity(const int &id, const glm::vec3 &velocity);
+    void setAlive(const int &id, const bool &alive);
+
+    // id of the nearest alive target in front of origin hit by the ray, -1 on a miss
+    int raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+    // center += velocity * deltaTime for every target
+    void integrate(const float &deltaTime);
+
+    // widest instruction set this cpu and os support, used by default
+    static SimdLevel detectSimdLevel();
+    void setSimdLevel(const SimdLevel &level);
+    SimdLevel getSimdLevel() const;
+};
\ No newline at end of file
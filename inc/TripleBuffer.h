@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// lock-free single writer / single reader hand-off of the latest value:
+// the writer fills its own slot and swaps it into the middle, the reader
+// swaps the middle out when it is newer. neither side ever waits, the
+// reader may skip values but always gets a complete one
+template <class T>
+class TripleBuffer
+{
+private:
+    static const unsigned int INDEX_MASK = 3;
+    static const unsigned int FRESH = 4; // middle slot was published and not read yet
+
+    std::array<T, 3> slots{};
+    alignas(64) std::atomic<unsigned int> middle{ 1 };
+    alignas(64) unsigned int back = 0;  // writer only
+    alignas(64) unsigned int front = 2; // reader only
+
+public:
+    // sets every slot, before either side runs. slots are reused as they
+    // are, so storage sized here is never allocated again
+    void reset(const T &value)
+    {
+        slots.fill(value);
+        middle.store(1, std::memory_order_relaxed);
+        back = 0;
+        front = 2;
+    }
+
+    // writer side: fill this, then publish()
+    T &writeSlot()
+    {
+        return slots[back];
+    }
+
+    void publish()
+    {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // reader side: take the latest published value, false if there is nothing new
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T &read() const
+    {
+        return slots[front];
+    }
+};
\ No newline at end of file
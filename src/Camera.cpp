@@ -1,4 +1,4 @@
-#include "../inc/camera.h"
+#include "../inc/Camera.h"
 #include <iostream>
 
 const glm::vec3 Camera::WORLDUP_DEFAULT = glm::vec3(0.0f, 1.0f, 0.0f);
@@ -30,7 +30,9 @@ Camera::Camera(const glm::vec3 &position, const glm::vec3 &front)
     near = NEAR_DEFAULT;
     far = FAR_DEFAULT;
 
-    updateCameraArgs();
+    orientationChanged = true;
+    viewChanged = true;
+    updatePersMatrix();
 }
 
 void Camera::setSpeed(const float &speed)
@@ -46,6 +48,7 @@ void Camera::setSensitivity(const float &sens)
 void Camera::setAspect(const float &aspect)
 {
     this->aspect = aspect;
+    updatePersMatrix();
 }
 
 glm::vec3 Camera::getPosition() const
@@ -55,22 +58,49 @@ glm::vec3 Camera::getPosition() const
 
 glm::vec3 Camera::getFront() const
 {
+    if (orientationChanged) updateCameraArgs();
     return front;
 }
 
+double Camera::getYaw() const
+{
+    return yaw;
+}
+
+double Camera::getPitch() const
+{
+    return pitch;
+}
+
+glm::vec3 Camera::frontFromAngles(const double &yaw, const double &pitch)
+{
+    glm::dvec3 newFront;
+    newFront.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
+    newFront.y = sin(glm::radians(pitch));
+    newFront.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
+    return glm::vec3(glm::normalize(newFront));
+}
+
 glm::mat4 Camera::getViewMatrix() const
 {
-    return glm::lookAt(position, position + front, up);
+    if (orientationChanged) updateCameraArgs();
+    if (viewChanged)
+    {
+        viewMatrix = glm::lookAt(position, position + front, up);
+        viewChanged = false;
+    }
+    return viewMatrix;
 }
 
 glm::mat4 Camera::getPersMatrix() const
 {
-    return glm::perspective(glm::radians(fov), aspect, near, far);
+    return persMatrix;
 }
 
 
 void Camera::bodyMove(const Movement &direction, const float &deltaTime)
 {
+    if (orientationChanged) updateCameraArgs();
     float distance = movementSpeed * deltaTime;
     if (direction == Movement::FORWARD) position += front * distance;
     if (direction == Movement::BACKWARD) position -= front * distance;
@@ -78,31 +108,48 @@ void Camera::bodyMove(const Movement &direction, const float &deltaTime)
     if (direction == Movement::RIGHT) position += right * distance;
     if (direction == Movement::WORLD_UP) position += worldUp * distance;
     if (direction == Movement::WORLD_DOWN) position -= worldUp * distance;
+    viewChanged = true;
 }
 
+// only accumulates the angles, the basis vectors are rebuilt once when next read
 void Camera::persMove(float xOffset, float yOffset)
 {
-    xOffset *= mouseSens;
-    yOffset *= mouseSens;
+    yaw += (double)xOffset * mouseSens;
+    pitch += (double)yOffset * mouseSens;
 
-    yaw += xOffset;
-    pitch += yOffset;
+    if (pitch > 89.0) pitch = 89.0;
+    if (pitch < -89.0) pitch = -89.0;
 
-    if (pitch > 89.0f) pitch = 89.0f;
-    if (pitch < -89.0f) pitch = -89.0f;
+    orientationChanged = true;
+}
 
-    updateCameraArgs();
+void Camera::setPose(const glm::vec3 &position, const double &yaw, const double &pitch)
+{
+    if (position != this->position)
+    {
+        this->position = position;
+        viewChanged = true;
+    }
+    if (yaw != this->yaw || pitch != this->pitch)
+    {
+        this->yaw = yaw;
+        this->pitch = pitch;
+        orientationChanged = true;
+    }
 }
 
-void Camera::updateCameraArgs()
+void Camera::updateCameraArgs() const
 {
-    glm::vec3 newFront;
-    newFront.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
-    newFront.y = sin(glm::radians(pitch));
-    newFront.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-    front = glm::normalize(newFront);
+    front = frontFromAngles(yaw, pitch);
     frontHorizontal = glm::normalize(glm::vec3(front.x, 0, front.z));
     // also re-calculate the Right and Up vector
     right = glm::normalize(glm::cross(front, worldUp));
     up = glm::normalize(glm::cross(right, front));
+    orientationChanged = false;
+    viewChanged = true;
+}
+
+void Camera::updatePersMatrix()
+{
+    persMatrix = glm::perspective(glm::radians(fov), aspect, near, far);
 }
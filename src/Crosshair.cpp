@@ -1,4 +1,5 @@
 #include "../inc/Crosshair.h"
+#include "../inc/RenderStats.h"
 
 Crosshair::Crosshair(const Shader &shader, const float &length, const glm::vec3 &color, const unsigned int &screenWidth, const unsigned int &screenHeight)
     :shader(shader),
@@ -55,6 +56,7 @@ void Crosshair::renderCrosshair()
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBindVertexArray(VAO);
     glDrawArrays(GL_LINES, 0, 4);
+    RenderStats::addDraw(0);
 
     glUseProgram(NULL);
 }
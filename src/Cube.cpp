@@ -1,7 +1,8 @@
 #include "../inc/Cube.h"
+#include "../inc/RenderStats.h"
 
-Cube::Cube(const glm::vec3 &position, const float &length_x, const float &length_y, const float &length_z, const glm::vec3 &color, const Shader &shader, const Camera &camera, const DirectLight &directLight)
-    : camera(camera), directLight(directLight), shader(shader)
+Cube::Cube(const glm::vec3 &position, const float &length_x, const float &length_y, const float &length_z, const glm::vec3 &color, const Shader &shader)
+    : shader(shader)
 {
     this->position = position;
     this->length_x = length_x;
@@ -9,6 +10,7 @@ Cube::Cube(const glm::vec3 &position, const float &length_x, const float &length
     this->length_z = length_z;
     this->color = color;
     initVertice();
+    initUniforms();
 }
 
 Cube::~Cube()
@@ -106,27 +108,27 @@ void Cube::renderCube()
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
+    RenderStats::addDraw(12);
     glUseProgram(NULL);
 }
 
+void Cube::initUniforms()
+{
+    uniforms.model = shader.uniform("model");
+    uniforms.shininess = shader.uniform("material.shininess");
+    uniforms.color = shader.uniform("aColor");
+}
+
 void Cube::setMatrix()
 {
     shader.use();
-    // camera
-    shader.setMat4("view", camera.getViewMatrix());
-    shader.setMat4("projection", camera.getPersMatrix());
-    shader.setVec3("cameraPos", camera.getPosition());
-
-    // direct light
-    shader.setVec3("directLight.direction", directLight.direction);
-    shader.setVec3("directLight.ambient", directLight.ambient);
-    shader.setVec3("directLight.diffuse", directLight.diffuse);
-    shader.setVec3("directLight.specular", directLight.specular);
+    // model, the vertices are already in world space
+    shader.setMat4(uniforms.model, glm::mat4(1.0f));
 
     // material
-    shader.setFloat("material.shininess", 16);
+    shader.setFloat(uniforms.shininess, 16);
 
-    shader.setVec3("aColor", color);
+    shader.setVec3(uniforms.color, color);
 
     // ---------------
     glUseProgram(NULL);
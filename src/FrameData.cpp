@@ -0,0 +1,46 @@
+#include "../inc/FrameData.h"
+
+FrameData::FrameData(const Camera &camera, const DirectLight &directLight)
+    : camera(camera), directLight(directLight)
+{
+    UBO = 0;
+}
+
+FrameData::~FrameData()
+{
+    glDeleteBuffers(1, &UBO);
+}
+
+void FrameData::init()
+{
+    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Block), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, UBO);
+}
+
+// fill the block once per frame, before anything is drawn
+void FrameData::update()
+{
+    // camera
+    block.view = camera.getViewMatrix();
+    block.projection = camera.getPersMatrix();
+    block.cameraPos = glm::vec4(camera.getPosition(), 1.0f);
+
+    // direct light
+    block.lightDirection = glm::vec4(directLight.direction, 0.0f);
+    block.lightAmbient = glm::vec4(directLight.ambient, 0.0f);
+    block.lightDiffuse = glm::vec4(directLight.diffuse, 0.0f);
+    block.lightSpecular = glm::vec4(directLight.specular, 0.0f);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Block), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
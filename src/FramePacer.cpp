@@ -0,0 +1,97 @@
+#include "../inc/FramePacer.h"
+
+#include <iostream>
+#include <thread>
+#include <algorithm>
+
+#include <GLFW/glfw3.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "winmm.lib")
+#endif
+#endif
+
+const Timestamp FramePacer::SPIN_MARGIN = 2000;
+
+FramePacer::FramePacer(const Mode &mode, const float &fpsCap, const float &jitWaitMs)
+{
+    this->mode = mode;
+    framePeriod = fpsCap > 0 ? (Timestamp)(1e6 / fpsCap) : 0;
+    jitWait = (Timestamp)(jitWaitMs * 1000);
+    nextFrame = 0;
+    lastPresent = 0;
+#ifdef _WIN32
+    timeBeginPeriod(1); // 1 ms sleeps instead of the 15.6 ms default
+#endif
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::init(const int &refreshRate)
+{
+    glfwSwapInterval(mode == Mode::VSYNC ? 1 : 0);
+    if (mode == Mode::CAPPED && framePeriod <= 0)
+    {
+        std::cout << "FramePacer: no fps cap given, running uncapped" << std::endl;
+        this->mode = Mode::UNCAPPED;
+    }
+    if (mode == Mode::VSYNC && refreshRate > 0)
+    {
+        // leave at least 2 ms of the refresh to render in, or the frame misses its vblank
+        Timestamp maxWait = std::max<Timestamp>(0, (Timestamp)(1e6 / refreshRate) - 2000);
+        if (jitWait > maxWait)
+        {
+            std::cout << "FramePacer: vsync wait clamped to " << maxWait / 1000.0 << " ms" << std::endl;
+            jitWait = maxWait;
+        }
+    }
+}
+
+void FramePacer::waitForFrame()
+{
+    if (mode == Mode::CAPPED)
+    {
+        Timestamp now = nowMicros();
+        // more than a frame behind, start over instead of running frames back to back
+        if (nextFrame < now - framePeriod) nextFrame = now;
+        waitUntil(nextFrame);
+        nextFrame += framePeriod;
+    }
+    else if (mode == Mode::VSYNC && jitWait > 0 && lastPresent > 0)
+    {
+        waitUntil(lastPresent + jitWait);
+    }
+}
+
+void FramePacer::framePresented(const Timestamp &time/* = nowMicros()*/)
+{
+    lastPresent = time;
+}
+
+FramePacer::Mode FramePacer::getMode() const
+{
+    return mode;
+}
+
+void FramePacer::waitUntil(const Timestamp &deadline)
+{
+    Timestamp remaining = deadline - nowMicros();
+    if (remaining > SPIN_MARGIN)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(remaining - SPIN_MARGIN));
+    }
+    while (nowMicros() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
\ No newline at end of file
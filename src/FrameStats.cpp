@@ -0,0 +1,113 @@
+#include "../inc/FrameStats.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+FrameStats::FrameStats(const double &windowSeconds/* = 5.0*/)
+{
+    for (auto &slot : ring)
+    {
+        slot.store(0, std::memory_order_relaxed);
+    }
+    writeIndex.store(0, std::memory_order_relaxed);
+    windowStart = 0;
+    windowLength = (Timestamp)(windowSeconds * 1e6);
+    sessionStart = 0;
+}
+
+Timestamp FrameStats::frameAt(const std::uint64_t &index) const
+{
+    return ring[index & (RING_SIZE - 1)].load(std::memory_order_relaxed);
+}
+
+void FrameStats::addFrame(const Timestamp &time/* = nowMicros()*/)
+{
+    std::uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    if (index == 0) sessionStart = time;
+
+    // the oldest slot is reused below, so it has to leave the window first
+    if (index - windowStart == RING_SIZE)
+    {
+        windowHistogram.remove(frameAt(windowStart + 1) - frameAt(windowStart));
+        windowStart++;
+    }
+
+    ring[index & (RING_SIZE - 1)].store(time, std::memory_order_relaxed);
+    writeIndex.store(index + 1, std::memory_order_release);
+    if (index == 0) return;
+
+    Timestamp frameTime = time - frameAt(index - 1);
+    windowHistogram.record(frameTime);
+    sessionHistogram.record(frameTime);
+
+    // drop the frames that ended before the window
+    while (windowStart + 1 < index && frameAt(windowStart + 1) < time - windowLength)
+    {
+        windowHistogram.remove(frameAt(windowStart + 1) - frameAt(windowStart));
+        windowStart++;
+    }
+}
+
+FrameStats::Summary FrameStats::summarize(const Histogram &histogram, const Timestamp &duration)
+{
+    auto toFps = [](const std::int64_t &frameTime) { return frameTime > 0 ? 1e6 / frameTime : 0.0; };
+    Summary summary;
+    summary.frames = histogram.count();
+    summary.averageFps = duration > 0 ? summary.frames * 1e6 / duration : 0.0;
+    summary.low1Fps = toFps(histogram.valueAtPercentile(0.99));
+    summary.low01Fps = toFps(histogram.valueAtPercentile(0.999));
+    summary.maxFrameMs = histogram.max() / 1000.0;
+    return summary;
+}
+
+FrameStats::Summary FrameStats::window() const
+{
+    std::uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    if (index < 2) return summarize(windowHistogram, 0);
+    return summarize(windowHistogram, frameAt(index - 1) - frameAt(windowStart));
+}
+
+FrameStats::Summary FrameStats::session() const
+{
+    std::uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    if (index < 2) return summarize(sessionHistogram, 0);
+    return summarize(sessionHistogram, frameAt(index - 1) - sessionStart);
+}
+
+int FrameStats::recentFrames(Timestamp *out, const int &maxCount) const
+{
+    std::uint64_t end = writeIndex.load(std::memory_order_acquire);
+    // one slot short of the ring, the writer may be storing into the next one
+    std::uint64_t count = std::min<std::uint64_t>({ end, (std::uint64_t)maxCount, RING_SIZE - 1 });
+    std::uint64_t begin = end - count;
+    for (std::uint64_t i = begin; i < end; i++)
+    {
+        out[i - begin] = frameAt(i);
+    }
+    // slots the writer reused while we were copying are dropped
+    std::uint64_t overwritten = writeIndex.load(std::memory_order_acquire) - end;
+    if (overwritten == 0) return (int)count;
+    std::uint64_t valid = count > overwritten ? count - overwritten : 0;
+    std::copy(out + (count - valid), out + count, out);
+    return (int)valid;
+}
+
+bool FrameStats::save(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "Failed to save frame stats to " << path << std::endl;
+        return false;
+    }
+    Summary summary = session();
+    out << "# frames " << summary.frames << ", average fps " << summary.averageFps
+        << ", 1% low fps " << summary.low1Fps << ", 0.1% low fps " << summary.low01Fps
+        << ", max frame time " << summary.maxFrameMs << " ms\n";
+    out << "frame_time_us,count\n";
+    sessionHistogram.forEachBucket([&](const std::int64_t &value, const std::uint32_t &count) {
+        out << value << "," << count << "\n";
+    });
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,499 @@
+#include "../inc/Game.h"
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#include <GLFW/glfw3.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "winmm.lib")
+#endif
+#endif
+
+namespace {
+    // arena, targets and spawn cells
+    const glm::vec3 ARENA_MIN(0.0f);
+    const glm::vec3 ARENA_MAX(40.0f, 18.0f, 20.0f);
+    const float GRID_CELL_SIZE = 2.0f;
+    // 5 x 5 spawn cells on the back wall
+    const glm::ivec3 SPAWN_CELLS(5, 5, 1);
+    const glm::vec3 SPAWN_ORIGIN(11.5f, 1.5f, 1.0f);
+    const glm::vec3 SPAWN_SPACING(3.0f);
+    // tracking mode: targets strafe across the back wall at 2 ~ 6 m/s
+    const glm::vec3 TRACKING_MIN(2.0f, 1.0f, 0.0f);
+    const glm::vec3 TRACKING_MAX(38.0f, 17.0f, 2.0f);
+    const float TRACKING_MIN_SPEED = 2.0f;
+    const float TRACKING_MAX_SPEED = 6.0f;
+}
+
+Game::Game(const Options &options, const std::uint64_t &seed, const Camera &camera, const Shader &targetShader)
+    : camera(camera),
+    targetGrid(ARENA_MIN, ARENA_MAX, GRID_CELL_SIZE),
+    targetPlacer(SPAWN_CELLS, SPAWN_ORIGIN, SPAWN_SPACING, seed),
+    simulation(TRACKING_MIN, TRACKING_MAX, TRACKING_MIN_SPEED, TRACKING_MAX_SPEED),
+    targetShader(targetShader)
+{
+    simulation.seed(seed + 1);
+    tracking = options.gameMode == Options::GameMode::TRACKING;
+    gpuPicking = options.hitMode == Options::HitMode::GPU_PICKING;
+    hitTimes = 0;
+    clickTimes = 0;
+    reactionTimeTotal = 0;
+    lastClickTime = 0;
+    std::fill(std::begin(moving), std::end(moving), false);
+    movedUntil = 0;
+    updateTime = 0;
+    inputsHandled = 0;
+    rawHandled = 0;
+    inputsPushed = 0;
+    publishCount = 0;
+    rawMouse = nullptr;
+    recorder = nullptr;
+    recordedPosition = glm::vec3(0.0f);
+    recordedYaw = 0;
+    recordedPitch = 0;
+    running = false;
+}
+
+Game::~Game()
+{
+    stop();
+}
+
+// targets are added before start(), which sizes the snapshots for them.
+// a hit target takes its next cell before leaving the old one, so one spawn
+// cell always stays free
+int Game::addTarget(const float &radius, const Timestamp &spawnTime/* = nowMicros()*/)
+{
+    if (targetPlacer.freeCount() <= 1)
+    {
+        std::cout << "Game: all " << targetPlacer.cellTotal() << " spawn cells in use, target not added" << std::endl;
+        return -1;
+    }
+    targets.push_back(std::make_unique<Sphere>(glm::vec3(-1.0f), radius, glm::vec3(1.0f), targetShader));
+    Sphere &target = *targets.back();
+    target.setGridPos(targetPlacer, spawnTime);
+    targetGrid.add(target);
+    shownSince.push_back(0);
+    simulation.addTarget(target.getCenter(), target.getRadius());
+    metrics.spawn(targets.size() - 1, spawnTime, camera.getFront());
+    if (recorder != nullptr) recorder->recordSpawn(spawnTime, targets.size() - 1, target.getGridPos());
+    return targets.size() - 1;
+}
+
+void Game::setRawMouse(RawMouse *rawMouse)
+{
+    this->rawMouse = rawMouse;
+}
+
+void Game::setRecorder(SessionRecorder *recorder)
+{
+    this->recorder = recorder;
+}
+
+SessionLog::Header Game::sessionHeader(const std::uint64_t &seed, const float &targetRadius) const
+{
+    SessionLog::Header header{};
+    header.magic = SessionLog::MAGIC;
+    header.version = SessionLog::VERSION;
+    header.gameMode = (std::uint8_t)(tracking ? Options::GameMode::TRACKING : Options::GameMode::STATIC);
+    header.hitMode = (std::uint8_t)(gpuPicking ? Options::HitMode::GPU_PICKING : Options::HitMode::RAY);
+    header.seed = seed;
+    header.targetRadius = targetRadius;
+    glm::vec3 position = camera.getPosition();
+    header.cameraPosition[0] = position.x;
+    header.cameraPosition[1] = position.y;
+    header.cameraPosition[2] = position.z;
+    header.cameraYaw = camera.getYaw();
+    header.cameraPitch = camera.getPitch();
+    return header;
+}
+
+void Game::start(const Timestamp &time, const bool &ownThread)
+{
+    movedUntil = time;
+    // every slot sized for all targets up front, publishing never allocates
+    Snapshot empty{};
+    empty.targetCenters.resize(targets.size());
+    snapshots.reset(empty);
+    if (tracking) simulation.start(time);
+    if (recorder != nullptr) recorder->recordStart(time);
+    publish(time);
+    if (!ownThread) return;
+
+    running = true;
+    thread = std::thread(&Game::run, this);
+}
+
+void Game::stop()
+{
+    if (!running.exchange(false)) return;
+    if (thread.joinable()) thread.join();
+}
+
+void Game::run()
+{
+#ifdef _WIN32
+    timeBeginPeriod(1); // 1 ms sleeps instead of the 15.6 ms default
+#endif
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point next = Clock::now();
+    while (running.load(std::memory_order_acquire))
+    {
+        update(nowMicros());
+        // after a stall start over instead of running the missed updates back to back
+        next = std::max(next + std::chrono::microseconds(Simulation::STEP), Clock::now());
+        std::this_thread::sleep_until(next);
+    }
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void Game::update(const Timestamp &now)
+{
+    updateTime = now;
+    // raw mouse and window events are each in order, merge what is queued by timestamp
+    InputEvent raw, window;
+    bool hasRaw = rawMouse != nullptr && rawMouse->peek(raw);
+    bool hasWindow = inputs.peek(window);
+    while (hasRaw || hasWindow)
+    {
+        if (hasRaw && (!hasWindow || raw.time <= window.time))
+        {
+            rawMouse->pop(raw);
+            handleInputEvent(raw);
+            rawHandled++;
+            hasRaw = rawMouse->peek(raw);
+        }
+        else
+        {
+            inputs.pop(window);
+            handleInputEvent(window);
+            inputsHandled++;
+            hasWindow = inputs.peek(window);
+        }
+    }
+
+    // clicks whose object id came back from the picking buffer
+    PickingBuffer::Result pick;
+    while (pickResults.pop(pick))
+    {
+        handlePick(pick);
+    }
+
+    advanceTo(now);
+    // input that arrives later is tested against the targets of this step,
+    // a replay has to step the simulation at the same times
+    if (tracking && recorder != nullptr) recorder->recordUpdate(now);
+    // moving targets and body movement change the aim without any input
+    updateAim(now);
+    publish(now);
+}
+
+// a frame drawn before the target respawned shows where it was, a second
+// click on it or a click on a frame still in flight is a miss
+void Game::handlePick(const PickingBuffer::Result &pick)
+{
+    if (recorder != nullptr) recorder->recordPick(pick.clickTime, pick.frameTime, updateTime, pick.objectId);
+    clickTimes++;
+    glm::vec3 front = clickFront(pick.clickTime);
+    int target = (int)pick.objectId - TARGET_ID_BASE;
+    if (target >= 0 && target < (int)targets.size() && pick.frameTime >= shownSince[target]) targetHit(target, pick.clickTime, front);
+    else if (recorder != nullptr) recorder->recordMiss(pick.clickTime);
+}
+
+// targets and body movement as they were at time, whatever the update rate
+void Game::advanceTo(const Timestamp &time)
+{
+    if (tracking) simulation.advanceTo(time);
+    if (time <= movedUntil) return;
+
+    float deltaTime = (time - movedUntil) / 1e6f;
+    for (int i = 0; i < 6; i++)
+    {
+        if (moving[i]) camera.bodyMove((Camera::Movement)i, deltaTime);
+    }
+    movedUntil = time;
+}
+
+void Game::handleInputEvent(const InputEvent &event)
+{
+    if (recorder != nullptr) recorder->recordInput(event);
+    advanceTo(event.time);
+    if (event.type == InputEvent::Type::MOUSE_MOVE)
+    {
+        camera.persMove(event.xOffset, event.yOffset);
+        updateAim(event.time);
+    }
+    else if (event.type == InputEvent::Type::KEY)
+    {
+        if (event.button >= 0 && event.button < 6) moving[event.button] = event.action != GLFW_RELEASE;
+    }
+    else if (event.button == GLFW_MOUSE_BUTTON_LEFT and event.action == GLFW_PRESS)
+    {
+        lastClickTime = event.time;
+        if (gpuPicking)
+        {
+            // the hit is handled a frame or two later, the flick is measured to where the view was now
+            if (pickRequests.push(event.time)) pendingClicks.push(PendingClick{ event.time, camera.getFront() });
+        }
+        else hitJudgement(event.time);
+    }
+}
+
+// the nearest target in front of the camera, -1 for none
+int Game::aimedTarget(float &distance)
+{
+    return tracking ? simulation.raycast(camera.getPosition(), camera.getFront(), distance)
+        : targetGrid.raycast(camera.getPosition(), camera.getFront(), distance);
+}
+
+void Game::updateAim(const Timestamp &time)
+{
+    float distance;
+    metrics.aim(aimedTarget(distance), time);
+}
+
+// only the nearest target in front of the camera counts
+void Game::hitJudgement(const Timestamp &clickTime)
+{
+    clickTimes++;
+    float distance;
+    int target = aimedTarget(distance);
+    if (target < 0)
+    {
+        if (recorder != nullptr) recorder->recordMiss(clickTime);
+        return;
+    }
+
+    targetHit(target, clickTime, camera.getFront());
+}
+
+// view direction at a picked click, picks come back in click order. clicks
+// whose pick got lost on the way are skipped
+glm::vec3 Game::clickFront(const Timestamp &clickTime)
+{
+    PendingClick click;
+    while (pendingClicks.peek(click) && click.time < clickTime)
+    {
+        pendingClicks.pop(click);
+    }
+    if (pendingClicks.peek(click) && click.time == clickTime)
+    {
+        pendingClicks.pop(click);
+        return click.front;
+    }
+    return camera.getFront();
+}
+
+// targets were added to the grid and the simulation in the same order, ids match
+void Game::targetHit(const int &target, const Timestamp &clickTime, const glm::vec3 &front)
+{
+    Sphere &sphere = targetGrid.getSphere(target);
+    hitTimes++;
+    reactionTimeTotal += clickTime - sphere.getSpawnTime();
+    if (recorder != nullptr) recorder->recordHit(clickTime, target, clickTime - sphere.getSpawnTime());
+    metrics.hit(target, clickTime, front);
+    sphere.setGridPos(targetPlacer, clickTime);
+    metrics.spawn(target, clickTime, front);
+    targetGrid.update(target);
+    shownSince[target] = updateTime;
+    if (tracking) simulation.respawn(target, sphere.getCenter());
+    if (recorder != nullptr) recorder->recordSpawn(clickTime, target, sphere.getGridPos());
+}
+
+void Game::publish(const Timestamp &time)
+{
+    if (recorder != nullptr)
+    {
+        glm::vec3 position = camera.getPosition();
+        if (position != recordedPosition || camera.getYaw() != recordedYaw || camera.getPitch() != recordedPitch)
+        {
+            recordedPosition = position;
+            recordedYaw = camera.getYaw();
+            recordedPitch = camera.getPitch();
+            recorder->recordCamera(time, recordedPosition, recordedYaw, recordedPitch);
+        }
+    }
+
+    Snapshot &snapshot = snapshots.writeSlot();
+    snapshot.time = time;
+    snapshot.cameraPosition = camera.getPosition();
+    snapshot.yaw = camera.getYaw();
+    snapshot.pitch = camera.getPitch();
+    for (int i = 0; i < (int)targets.size(); i++)
+    {
+        // tracking targets one step behind, between the last two steps
+        snapshot.targetCenters[i] = tracking ? simulation.getDisplayPosition(i, time) : targets[i]->getCenter();
+    }
+    snapshot.hitTimes = hitTimes;
+    snapshot.clickTimes = clickTimes;
+    snapshot.reactionTimeTotal = reactionTimeTotal;
+    snapshot.lastClickTime = lastClickTime;
+    snapshot.metrics = metrics.getSummary();
+    snapshot.inputSequence = inputsHandled;
+    snapshot.rawSequence = rawHandled;
+    snapshots.publish();
+    {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        publishCount++;
+    }
+    published.notify_one();
+}
+
+bool Game::replay(SessionReader &reader)
+{
+    const SessionLog::Header &header = reader.getHeader();
+    bool started = false;
+    int recordedHits = 0;
+    int recordedClicks = 0;
+    int mismatches = 0; // camera poses and spawn cells that differ from the recording
+
+    SessionLog::RecordType type;
+    const char *payload;
+    while (reader.next(type, payload))
+    {
+        if (type == SessionLog::RecordType::START)
+        {
+            SessionLog::Start record;
+            std::memcpy(&record, payload, sizeof(record));
+            start(record.time, false);
+            started = true;
+        }
+        else if (type == SessionLog::RecordType::INPUT)
+        {
+            SessionLog::Input record;
+            std::memcpy(&record, payload, sizeof(record));
+            InputEvent event{};
+            event.type = (InputEvent::Type)record.type;
+            event.time = record.time;
+            event.xOffset = record.xOffset;
+            event.yOffset = record.yOffset;
+            event.button = record.button;
+            event.action = record.action;
+            handleInputEvent(event);
+            // the picks were recorded, nobody renders the requests
+            Timestamp clickTime;
+            while (pickRequests.pop(clickTime));
+        }
+        else if (type == SessionLog::RecordType::PICK)
+        {
+            SessionLog::Pick record;
+            std::memcpy(&record, payload, sizeof(record));
+            // the update the result came back in, respawns are shown from then on
+            updateTime = record.handledTime;
+            handlePick(PickingBuffer::Result{ record.objectId, record.time, record.frameTime });
+        }
+        else if (type == SessionLog::RecordType::CAMERA)
+        {
+            SessionLog::Camera record;
+            std::memcpy(&record, payload, sizeof(record));
+            // the update this pose was recorded at, so movement is integrated over the same steps
+            advanceTo(record.time);
+            glm::vec3 position = camera.getPosition();
+            glm::vec3 recorded(record.position[0], record.position[1], record.position[2]);
+            if (glm::any(glm::greaterThan(glm::abs(position - recorded), glm::vec3(1e-3f)))
+                || std::abs((float)camera.getYaw() - record.yaw) > 1e-3f || std::abs((float)camera.getPitch() - record.pitch) > 1e-3f)
+            {
+                mismatches++;
+            }
+        }
+        else if (type == SessionLog::RecordType::UPDATE)
+        {
+            SessionLog::Update record;
+            std::memcpy(&record, payload, sizeof(record));
+            advanceTo(record.time);
+            updateAim(record.time);
+        }
+        else if (type == SessionLog::RecordType::SPAWN)
+        {
+            SessionLog::Spawn record;
+            std::memcpy(&record, payload, sizeof(record));
+            // the initial targets, spawned before the game started
+            if (!started && record.target == targets.size()) addTarget(header.targetRadius, record.time);
+            if (record.target >= targets.size() || targets[record.target]->getGridPos() != record.cell) mismatches++;
+        }
+        else if (type == SessionLog::RecordType::HIT)
+        {
+            recordedHits++;
+            recordedClicks++;
+        }
+        else if (type == SessionLog::RecordType::MISS)
+        {
+            recordedClicks++;
+        }
+    }
+
+    double reactionTime = hitTimes > 0 ? reactionTimeTotal / 1000.0 / hitTimes : 0;
+    std::cout << "Replay: " << hitTimes << " hits of " << clickTimes << " clicks, reaction " << reactionTime << " ms" << std::endl;
+    bool matches = hitTimes == recordedHits && clickTimes == recordedClicks && mismatches == 0;
+    if (!matches)
+    {
+        std::cout << "Replay differs from the recording: " << recordedHits << " hits of " << recordedClicks << " clicks recorded, "
+            << mismatches << " camera poses or spawns differ" << std::endl;
+    }
+    return matches;
+}
+
+bool Game::pushInput(const InputEvent &event)
+{
+    if (!inputs.push(event)) return false;
+    inputsPushed++;
+    return true;
+}
+
+bool Game::popPickRequest(Timestamp &clickTime)
+{
+    return pickRequests.pop(clickTime);
+}
+
+bool Game::pushPickResult(const PickingBuffer::Result &result)
+{
+    return pickResults.push(result);
+}
+
+bool Game::updateSnapshot()
+{
+    return snapshots.update();
+}
+
+// the game thread handles the queue at most a STEP later. waiting for it
+// keeps the view matrix from lagging the polled mouse by a frame, and a frame
+// without new input does not wait at all
+bool Game::waitForInputs(const Timestamp &timeout)
+{
+    updateSnapshot();
+    if (!running.load(std::memory_order_acquire)) return true; // update() ran on this thread
+    std::uint64_t rawQueued = rawMouse != nullptr ? rawMouse->queuedCount() : 0;
+    auto handled = [&]() {
+        const Snapshot &latest = snapshot();
+        return latest.inputSequence >= inputsPushed && latest.rawSequence >= rawQueued;
+    };
+    if (handled()) return true;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+    std::unique_lock<std::mutex> lock(publishMutex);
+    while (true)
+    {
+        std::uint64_t seen = publishCount;
+        lock.unlock();
+        updateSnapshot();
+        if (handled()) return true;
+        lock.lock();
+        if (!published.wait_until(lock, deadline, [&]() { return publishCount != seen; })) return false;
+    }
+}
+
+const Game::Snapshot &Game::snapshot() const
+{
+    return snapshots.read();
+}
\ No newline at end of file
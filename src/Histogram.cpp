@@ -0,0 +1,109 @@
+#include "../inc/Histogram.h"
+
+#include <bit>
+#include <algorithm>
+
+namespace {
+    const int SUB_BUCKETS = 1 << Histogram::SUB_BUCKET_BITS;
+    const int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+    const int BUCKETS = Histogram::MAX_BITS - Histogram::SUB_BUCKET_BITS + 1;
+    const std::int64_t MAX_VALUE = (std::int64_t(1) << Histogram::MAX_BITS) - 1;
+}
+
+Histogram::Histogram()
+{
+    counts.assign((BUCKETS + 1) * HALF_SUB_BUCKETS, 0);
+    reset();
+}
+
+// bucket 0 holds 0 ~ SUB_BUCKETS - 1 one per slot, bucket b > 0 holds the values
+// with their top bit at SUB_BUCKET_BITS - 1 + b, in steps of 2^b
+int Histogram::indexOf(std::int64_t value)
+{
+    value = std::clamp<std::int64_t>(value, 0, MAX_VALUE);
+    int bucket = std::max(0, (int)std::bit_width((std::uint64_t)value) - SUB_BUCKET_BITS);
+    int subBucket = (int)(value >> bucket);
+    return bucket * HALF_SUB_BUCKETS + subBucket;
+}
+
+std::int64_t Histogram::valueOf(const int &index)
+{
+    if (index < SUB_BUCKETS) return index;
+    int bucket = index / HALF_SUB_BUCKETS - 1;
+    int subBucket = index - bucket * HALF_SUB_BUCKETS;
+    return ((std::int64_t)subBucket << bucket) + ((std::int64_t(1) << bucket) >> 1);
+}
+
+void Histogram::record(std::int64_t value)
+{
+    counts[indexOf(value)]++;
+    totalCount++;
+    sum += value;
+    maxValue = std::max(maxValue, value);
+}
+
+void Histogram::remove(std::int64_t value)
+{
+    int index = indexOf(value);
+    if (counts[index] == 0) return;
+    counts[index]--;
+    totalCount--;
+    sum -= value;
+    if (value < maxValue) return;
+
+    // the maximum left the window, fall back to the highest non-empty bucket
+    maxValue = 0;
+    for (int i = (int)counts.size() - 1; i >= 0; i--)
+    {
+        if (counts[i] == 0) continue;
+        maxValue = valueOf(i);
+        break;
+    }
+}
+
+void Histogram::reset()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+void Histogram::add(const Histogram &other)
+{
+    for (int i = 0; i < (int)counts.size(); i++)
+    {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    sum += other.sum;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+std::int64_t Histogram::count() const
+{
+    return totalCount;
+}
+
+double Histogram::mean() const
+{
+    return totalCount > 0 ? (double)sum / totalCount : 0.0;
+}
+
+std::int64_t Histogram::max() const
+{
+    return maxValue;
+}
+
+std::int64_t Histogram::valueAtPercentile(const double &percentile) const
+{
+    if (totalCount == 0) return 0;
+    std::int64_t target = std::max<std::int64_t>(1, (std::int64_t)(percentile * totalCount + 0.5));
+    std::int64_t seen = 0;
+    for (int i = 0; i < (int)counts.size(); i++)
+    {
+        seen += counts[i];
+        if (seen >= target) return std::min(valueOf(i), maxValue);
+    }
+    return maxValue;
+}
\ No newline at end of file
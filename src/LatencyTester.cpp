@@ -0,0 +1,135 @@
+#include "../inc/LatencyTester.h"
+#include "../inc/RenderStats.h"
+
+#include <iostream>
+#include <fstream>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+const float LatencyTester::MARKER_SIZE = 64.0f;
+
+// bottom right corner, where the photodiode goes
+LatencyTester::LatencyTester(const Shader &shader, const unsigned int &screenWidth, const unsigned int &screenHeight, const bool &useFence)
+    :shader(shader),
+    vertices{
+        screenWidth - MARKER_SIZE, 0.0f,
+        (float)screenWidth, 0.0f,
+        screenWidth - MARKER_SIZE, MARKER_SIZE,
+        (float)screenWidth, MARKER_SIZE,
+}
+{
+    this->screenWidth = screenWidth;
+    this->screenHeight = screenHeight;
+    this->useFence = useFence;
+    VBO = 0;
+    VAO = 0;
+    markerWhite = false;
+    lastClickTime = 0;
+    pendingClick = 0;
+}
+
+LatencyTester::~LatencyTester()
+{
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void LatencyTester::init()
+{
+    if (glGetError() == GL_INVALID_OPERATION)
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+
+    glGenBuffers(1, &VBO);
+    glGenVertexArrays(1, &VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    glBindVertexArray(VAO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+
+    glm::mat4 projection = glm::ortho(0.0f, static_cast<GLfloat>(screenWidth), 0.0f, static_cast<GLfloat>(screenHeight));
+    shader.use();
+    shader.setMat4("projection", projection);
+    colorUniform = shader.uniform("color");
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void LatencyTester::click(const Timestamp &clickTime)
+{
+    if (clickTime == lastClickTime) return;
+
+    // clicks between two frames show up in the same frame, the latest is measured
+    lastClickTime = clickTime;
+    pendingClick = clickTime;
+    markerWhite = !markerWhite;
+}
+
+void LatencyTester::renderMarker()
+{
+    shader.use();
+    shader.setVec3(colorUniform, markerWhite ? glm::vec3(1.0f) : glm::vec3(0.0f));
+
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    RenderStats::addDraw(2);
+
+    glBindVertexArray(0);
+    glUseProgram(NULL);
+}
+
+void LatencyTester::framePresented(const Timestamp &time/* = nowMicros()*/)
+{
+    if (pendingClick == 0) return;
+
+    swapLatency.record(time - pendingClick);
+    if (useFence)
+    {
+        // commands after the swap, so this signals once the frame itself is done
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // 100 ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) gpuLatency.record(nowMicros() - pendingClick);
+        glDeleteSync(fence);
+    }
+    pendingClick = 0;
+}
+
+const Histogram &LatencyTester::getSwapLatency() const
+{
+    return swapLatency;
+}
+
+const Histogram &LatencyTester::getGpuLatency() const
+{
+    return gpuLatency;
+}
+
+bool LatencyTester::save(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "Failed to save latency results to " << path << std::endl;
+        return false;
+    }
+    out << "# clicks " << swapLatency.count() << ", click to swap p50 " << swapLatency.valueAtPercentile(0.5) / 1000.0
+        << " ms, p99 " << swapLatency.valueAtPercentile(0.99) / 1000.0 << " ms, max " << swapLatency.max() / 1000.0 << " ms\n";
+    if (gpuLatency.count() > 0)
+    {
+        out << "# click to gpu done p50 " << gpuLatency.valueAtPercentile(0.5) / 1000.0
+            << " ms, p99 " << gpuLatency.valueAtPercentile(0.99) / 1000.0 << " ms, max " << gpuLatency.max() / 1000.0 << " ms\n";
+    }
+    out << "stage,latency_us,count\n";
+    swapLatency.forEachBucket([&](const std::int64_t &value, const std::uint32_t &count) {
+        out << "swap," << value << "," << count << "\n";
+    });
+    gpuLatency.forEachBucket([&](const std::int64_t &value, const std::uint32_t &count) {
+        out << "gpu," << value << "," << count << "\n";
+    });
+    return true;
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "../inc/MyPrinter.h"
+#include "../inc/RenderStats.h"
 #include <filesystem>
+#include <algorithm>
 
 MyPrinter::MyPrinter(const std::string &fontPath, const Shader &textShader, const unsigned int &screenWidth, const unsigned int &screenHeight)
     : textShader(textShader)
@@ -13,6 +15,8 @@ MyPrinter::MyPrinter(const std::string &fontPath, const Shader &textShader, cons
 
     this->screenWidth = screenWidth;
     this->screenHeight = screenHeight;
+    bufferCapacity = 0;
+    retainedCapacity = 0;
 
 
     // load font
@@ -25,119 +29,251 @@ MyPrinter::MyPrinter(const std::string &fontPath, const Shader &textShader, cons
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
     FT_Set_Pixel_Sizes(face, 0, 48);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); //禁用字节对齐限制
-    for (GLubyte c = 0; c < 128; c++)
+    // 把所有字形排进一张图集，逐行摆放，字形之间留 1 像素避免采样串色
+    std::vector<std::vector<unsigned char>> bitmaps(GLYPH_COUNT);
+    std::vector<glm::ivec2> offsets(GLYPH_COUNT, glm::ivec2(0));
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (GLubyte c = 0; c < GLYPH_COUNT; c++)
     {
+        Characters[c] = {};
         // 加载字符的字形 
         if (FT_Load_Char(face, c, FT_LOAD_RENDER))
         {
             std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
             continue;
         }
-        // 生成纹理
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-        );
-        // 设置纹理选项
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        int width = face->glyph->bitmap.width;
+        int rows = face->glyph->bitmap.rows;
+        if (penX + width + 1 > ATLAS_WIDTH)
+        {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        offsets[c] = glm::ivec2(penX, penY);
+        penX += width + 1;
+        rowHeight = std::max(rowHeight, rows);
+
+        // bitmap.pitch 可能大于 width，逐行拷贝
+        bitmaps[c].resize(width * rows);
+        for (int row = 0; row < rows; row++)
+        {
+            std::copy_n(face->glyph->bitmap.buffer + row * face->glyph->bitmap.pitch, width, bitmaps[c].data() + row * width);
+        }
         // 储存字符供之后使用
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        Characters[c] = {
+            glm::ivec2(width, rows),
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            face->glyph->advance.x
+            static_cast<GLuint>(face->glyph->advance.x),
+            glm::vec2(0.0f),
+            glm::vec2(0.0f)
         };
-        Characters.insert(std::pair<GLchar, Character>(c, character));
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 
+    int atlasHeight = penY + rowHeight;
+    std::vector<unsigned char> atlas(ATLAS_WIDTH * atlasHeight, 0);
+    for (int c = 0; c < GLYPH_COUNT; c++)
+    {
+        Character &ch = Characters[c];
+        for (int row = 0; row < ch.size.y; row++)
+        {
+            std::copy_n(bitmaps[c].data() + row * ch.size.x, ch.size.x, atlas.data() + (offsets[c].y + row) * ATLAS_WIDTH + offsets[c].x);
+        }
+        ch.uvMin = glm::vec2((float)offsets[c].x / ATLAS_WIDTH, (float)offsets[c].y / atlasHeight);
+        ch.uvMax = glm::vec2((float)(offsets[c].x + ch.size.x) / ATLAS_WIDTH, (float)(offsets[c].y + ch.size.y) / atlasHeight);
+    }
+
+    // 生成图集纹理
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); //禁用字节对齐限制
+    glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, ATLAS_WIDTH, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+    // 设置纹理选项
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    //GLuint VAO, VBO;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    initVertexArray(VAO, VBO);
+    glGenVertexArrays(1, &retainedVAO);
+    glGenBuffers(1, &retainedVBO);
+    initVertexArray(retainedVAO, retainedVBO);
     glm::mat4 projection = glm::ortho(0.0f, static_cast<GLfloat>(screenWidth), 0.0f, static_cast<GLfloat>(screenHeight));
     textShader.use();
     textShader.setMat4("projection", projection);
+    textShader.setInt("text", 0);
+
+    batch.reserve(256 * 6 * FLOATS_PER_VERTEX);
 }
 
 MyPrinter::~MyPrinter()
 {
     textShader.use();
     glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &retainedVBO);
+    glDeleteVertexArrays(1, &retainedVAO);
+    glDeleteTextures(1, &atlasTexture);
+}
 
-    for (auto &it : Characters)
-    {
-        if (it.second.textureID)
-            glDeleteTextures(1, &it.second.textureID);
-    }
+void MyPrinter::initVertexArray(const GLuint &vao, const GLuint &vbo)
+{
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(GLfloat), 0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(GLfloat), (void *)(4 * sizeof(GLfloat)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 }
 
-void MyPrinter::renderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, glm::vec3 color)
+void MyPrinter::beginText()
 {
-    // 激活对应的渲染状态
-    textShader.use();
-    textShader.setVec3("textColor", color);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    batch.clear();
+}
 
+// write 6 vertices per character to out, return the number of floats written
+int MyPrinter::layoutText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color, GLfloat *out) const
+{
+    GLfloat *begin = out;
     // 遍历文本中所有的字符
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++)
+    for (char c : text)
     {
-        Character ch = Characters[*c];
+        const Character &ch = Characters[static_cast<unsigned char>(c) & (GLYPH_COUNT - 1)];
 
         GLfloat xpos = x + ch.bearing.x * scale;
         GLfloat ypos = y - (ch.size.y - ch.bearing.y) * scale;
 
         GLfloat w = ch.size.x * scale;
         GLfloat h = ch.size.y * scale;
-        // 对每个字符更新VBO
-        GLfloat vertices[6][4] = {
-            { xpos,     ypos + h,   0.0, 0.0 },
-            { xpos,     ypos,       0.0, 1.0 },
-            { xpos + w, ypos,       1.0, 1.0 },
-
-            { xpos,     ypos + h,   0.0, 0.0 },
-            { xpos + w, ypos,       1.0, 1.0 },
-            { xpos + w, ypos + h,   1.0, 0.0 }
+        // 每个字符两个三角形，纹理坐标取自图集
+        const GLfloat vertices[6][FLOATS_PER_VERTEX] = {
+            { xpos,     ypos + h,   ch.uvMin.x, ch.uvMin.y, color.x, color.y, color.z },
+            { xpos,     ypos,       ch.uvMin.x, ch.uvMax.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.uvMax.x, ch.uvMax.y, color.x, color.y, color.z },
+
+            { xpos,     ypos + h,   ch.uvMin.x, ch.uvMin.y, color.x, color.y, color.z },
+            { xpos + w, ypos,       ch.uvMax.x, ch.uvMax.y, color.x, color.y, color.z },
+            { xpos + w, ypos + h,   ch.uvMax.x, ch.uvMin.y, color.x, color.y, color.z }
         };
-        // 在四边形上绘制字形纹理
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        // 更新VBO内存的内容
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // 绘制四边形
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        out = std::copy_n(&vertices[0][0], 6 * FLOATS_PER_VERTEX, out);
         // 更新位置到下一个字形的原点，注意单位是1/64像素
         x += (ch.advance >> 6) * scale; // 位偏移6个单位来获取单位为像素的值 (2^6 = 64)
     }
+    return out - begin;
+}
+
+void MyPrinter::addText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color)
+{
+    size_t oldSize = batch.size();
+    batch.resize(oldSize + text.size() * 6 * FLOATS_PER_VERTEX);
+    layoutText(text, x, y, scale, color, batch.data() + oldSize);
+}
+
+void MyPrinter::flush()
+{
+    if (batch.empty()) return;
+
+    // 激活对应的渲染状态
+    textShader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glBindVertexArray(VAO);
+
+    // 一次性上传本帧所有文字的顶点
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if ((int)batch.size() > bufferCapacity)
+    {
+        bufferCapacity = batch.capacity();
+        glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, batch.size() * sizeof(GLfloat), batch.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArrays(GL_TRIANGLES, 0, batch.size() / FLOATS_PER_VERTEX);
+    RenderStats::addDraw(batch.size() / FLOATS_PER_VERTEX / 3);
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    batch.clear();
+}
+
+void MyPrinter::renderText(std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color)
+{
+    beginText();
+    addText(text, x, y, scale, color);
+    flush();
+}
+
+int MyPrinter::createText(GLfloat x, GLfloat y, GLfloat scale, const glm::vec3 &color, const int &capacity/* = 64*/)
+{
+    TextElement element;
+    element.x = x;
+    element.y = y;
+    element.scale = scale;
+    element.color = color;
+    element.text.reserve(capacity);
+    element.capacity = capacity;
+    element.firstFloat = retainedVertices.size();
+    element.dirty = false;
+    elements.push_back(std::move(element));
+    // all zero quads are degenerate and draw nothing
+    retainedVertices.resize(retainedVertices.size() + capacity * 6 * FLOATS_PER_VERTEX, 0.0f);
+    return elements.size() - 1;
+}
+
+void MyPrinter::setText(const int &id, std::string_view text)
+{
+    TextElement &element = elements[id];
+    if (text.size() > (size_t)element.capacity) text = text.substr(0, element.capacity);
+    if (element.text == text) return; // nothing to lay out again
+
+    element.text.assign(text.data(), text.size());
+    GLfloat *out = retainedVertices.data() + element.firstFloat;
+    int written = layoutText(text, element.x, element.y, element.scale, element.color, out);
+    std::fill(out + written, out + element.capacity * 6 * FLOATS_PER_VERTEX, 0.0f);
+    element.dirty = true;
+}
+
+void MyPrinter::renderTexts()
+{
+    if (retainedVertices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, retainedVBO);
+    if ((int)retainedVertices.size() > retainedCapacity)
+    {
+        // elements were created since the last frame, upload everything
+        retainedCapacity = retainedVertices.size();
+        glBufferData(GL_ARRAY_BUFFER, retainedCapacity * sizeof(GLfloat), retainedVertices.data(), GL_DYNAMIC_DRAW);
+        for (auto &element : elements) element.dirty = false;
+    }
+    else
+    {
+        // only the elements whose text changed
+        for (auto &element : elements)
+        {
+            if (!element.dirty) continue;
+            glBufferSubData(GL_ARRAY_BUFFER, element.firstFloat * sizeof(GLfloat), element.capacity * 6 * FLOATS_PER_VERTEX * sizeof(GLfloat), retainedVertices.data() + element.firstFloat);
+            element.dirty = false;
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // 激活对应的渲染状态
+    textShader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glBindVertexArray(retainedVAO);
+    glDrawArrays(GL_TRIANGLES, 0, retainedVertices.size() / FLOATS_PER_VERTEX);
+    RenderStats::addDraw(retainedVertices.size() / FLOATS_PER_VERTEX / 3);
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
\ No newline at end of file
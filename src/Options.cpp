@@ -0,0 +1,160 @@
+#include "../inc/Options.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+namespace {
+    void printUsage(const char *program)
+    {
+        std::cout << "usage: " << program << " [options]" << std::endl
+            << "  --input glfw|raw    mouse input through GLFW callbacks (default) or a raw input thread" << std::endl
+            << "  --mode static|tracking  static targets (default) or strafing targets to track" << std::endl
+            << "  --hit ray|gpu       hit test with a ray (default) or by reading the object id under the crosshair" << std::endl
+            << "  --threading split|single  game on its own thread (default) or updated by the render loop" << std::endl
+            << "  --present uncapped|capped|vsync  frame presentation (default uncapped)" << std::endl
+            << "  --fps-cap N         frame rate of --present capped (default 240)" << std::endl
+            << "  --jit-wait MS       with vsync, wait MS after each swap before sampling input (default 0)" << std::endl
+            << "  --seed N            seed of the target placement, the same seed places targets identically" << std::endl
+            << "  --profile-out FILE  record the profiler samples and write them to FILE as csv on exit" << std::endl
+            << "  --stats-out FILE    write the frame time statistics to FILE as csv on exit" << std::endl
+            << "  --latency-test      flip a marker in the bottom right corner on every click and measure click to swap latency" << std::endl
+            << "  --latency-fence     with --latency-test, also measure when the GPU finished the frame" << std::endl
+            << "  --latency-out FILE  where the latency histograms are saved on exit (default latency.csv)" << std::endl
+            << "  --record FILE       record the session to FILE, for --replay and AimStats" << std::endl
+            << "  --replay FILE       replay a recorded session without a window and print its score" << std::endl
+            << "  --watch-shaders     reload the shaders under src/shader when they are saved" << std::endl
+            << "  --no-shader-cache   compile the shaders on every launch instead of loading linked programs from shader_cache" << std::endl;
+    }
+
+    // value must be a number as a whole, a typo keeps the default instead of ending the program
+    template <class T, class F>
+    bool parseNumber(const char *program, const std::string_view &arg, const std::string &value, T &target, F parse)
+    {
+        try
+        {
+            std::size_t length = 0;
+            T parsed = parse(value, &length);
+            if (length != value.size()) throw std::invalid_argument(value);
+            target = parsed;
+            return true;
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(program);
+            return false;
+        }
+    }
+}
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--input" && hasValue)
+        {
+            std::string_view value = argv[++i];
+            if (value == "raw") options.inputMode = Options::InputMode::RAW_THREAD;
+            else if (value == "glfw") options.inputMode = Options::InputMode::GLFW;
+            else std::cout << "Unknown input mode: " << value << std::endl;
+        }
+        else if (arg == "--mode" && hasValue)
+        {
+            std::string_view value = argv[++i];
+            if (value == "tracking") options.gameMode = Options::GameMode::TRACKING;
+            else if (value == "static") options.gameMode = Options::GameMode::STATIC;
+            else std::cout << "Unknown mode: " << value << std::endl;
+        }
+        else if (arg == "--hit" && hasValue)
+        {
+            std::string_view value = argv[++i];
+            if (value == "gpu") options.hitMode = Options::HitMode::GPU_PICKING;
+            else if (value == "ray") options.hitMode = Options::HitMode::RAY;
+            else std::cout << "Unknown hit mode: " << value << std::endl;
+        }
+        else if (arg == "--threading" && hasValue)
+        {
+            std::string_view value = argv[++i];
+            if (value == "single") options.threading = Options::Threading::SINGLE;
+            else if (value == "split") options.threading = Options::Threading::SPLIT;
+            else std::cout << "Unknown threading: " << value << std::endl;
+        }
+        else if (arg == "--present" && hasValue)
+        {
+            std::string_view value = argv[++i];
+            if (value == "uncapped") options.presentMode = Options::PresentMode::UNCAPPED;
+            else if (value == "capped") options.presentMode = Options::PresentMode::CAPPED;
+            else if (value == "vsync") options.presentMode = Options::PresentMode::VSYNC;
+            else std::cout << "Unknown present mode: " << value << std::endl;
+        }
+        else if (arg == "--fps-cap" && hasValue)
+        {
+            parseNumber(argv[0], arg, argv[++i], options.fpsCap,
+                [](const std::string &value, std::size_t *length) { return std::stof(value, length); });
+        }
+        else if (arg == "--jit-wait" && hasValue)
+        {
+            parseNumber(argv[0], arg, argv[++i], options.jitWaitMs,
+                [](const std::string &value, std::size_t *length) { return std::stof(value, length); });
+        }
+        else if (arg == "--seed" && hasValue)
+        {
+            // stoull takes "-1" and wraps it to 2^64 - 1
+            if (parseNumber(argv[0], arg, argv[++i], options.seed,
+                [](const std::string &value, std::size_t *length) {
+                    if (value.find('-') != std::string::npos) throw std::invalid_argument(value);
+                    return std::stoull(value, length);
+                }))
+            {
+                options.hasSeed = true;
+            }
+        }
+        else if (arg == "--profile-out" && hasValue)
+        {
+            options.profileOutPath = argv[++i];
+        }
+        else if (arg == "--stats-out" && hasValue)
+        {
+            options.statsOutPath = argv[++i];
+        }
+        else if (arg == "--latency-test")
+        {
+            options.latencyTest = true;
+        }
+        else if (arg == "--latency-fence")
+        {
+            options.latencyFence = true;
+        }
+        else if (arg == "--latency-out" && hasValue)
+        {
+            options.latencyOutPath = argv[++i];
+        }
+        else if (arg == "--record" && hasValue)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if (arg == "--no-shader-cache")
+        {
+            options.shaderCachePath.clear();
+        }
+        else if (arg == "--watch-shaders")
+        {
+            options.watchShaders = true;
+        }
+        else if (arg == "--replay" && hasValue)
+        {
+            options.replayPath = argv[++i];
+        }
+        else
+        {
+            std::cout << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+        }
+    }
+    return options;
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "../inc/PickingBuffer.h"
+
+#include <iostream>
+
+PickingBuffer::PickingBuffer()
+{
+    FBO = 0;
+    colorBuffer = idBuffer = depthBuffer = 0;
+    width = height = 0;
+    pendingHead = 0;
+    pendingCount = 0;
+    for (auto &pick : pending)
+    {
+        pick.PBO = 0;
+        pick.fence = nullptr;
+        pick.clickTime = 0;
+        pick.frameTime = 0;
+    }
+}
+
+PickingBuffer::~PickingBuffer()
+{
+    if (FBO == 0) return;
+    for (auto &pick : pending)
+    {
+        if (pick.fence != nullptr) glDeleteSync(pick.fence);
+        glDeleteBuffers(1, &pick.PBO);
+    }
+    glDeleteFramebuffers(1, &FBO);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &idBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+}
+
+void PickingBuffer::init(const unsigned int &width, const unsigned int &height)
+{
+    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+    this->width = width;
+    this->height = height;
+
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &idBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, idBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, width, height);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_RENDERBUFFER, idBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    const GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Picking framebuffer is not complete" << std::endl;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // one pixel each
+    for (auto &pick : pending)
+    {
+        glGenBuffers(1, &pick.PBO);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pick.PBO);
+        glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    requested.reserve(64);
+}
+
+void PickingBuffer::bind(const glm::vec4 &clearColor)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    // glClear is undefined for integer attachments, clear each buffer on its own
+    const GLuint noObject[] = { 0, 0, 0, 0 };
+    glClearBufferfv(GL_COLOR, 0, &clearColor.x);
+    glClearBufferuiv(GL_COLOR, 1, noObject);
+    glClearBufferfi(GL_DEPTH_STENCIL, 0, 1.0f, 0);
+}
+
+void PickingBuffer::requestPick(const Timestamp &clickTime)
+{
+    requested.push_back(clickTime);
+}
+
+void PickingBuffer::readPicks(const Timestamp &frameTime)
+{
+    if (requested.empty()) return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    size_t issued = 0;
+    for (; issued < requested.size() && pendingCount < MAX_PENDING; issued++)
+    {
+        PendingPick &pick = pending[(pendingHead + pendingCount) % MAX_PENDING];
+        // into the PBO, returns immediately
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pick.PBO);
+        glReadPixels(width / 2, height / 2, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, (void *)0);
+        pick.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        pick.clickTime = requested[issued];
+        pick.frameTime = frameTime;
+        pendingCount++;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // the ones that did not fit wait for the next frame
+    requested.erase(requested.begin(), requested.begin() + issued);
+}
+
+void PickingBuffer::present()
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // the overlays drawn next still depth test against the default framebuffer
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+bool PickingBuffer::poll(Result &result)
+{
+    if (pendingCount == 0) return false;
+
+    PendingPick &pick = pending[pendingHead];
+    GLenum status = glClientWaitSync(pick.fence, 0, 0); // do not wait
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+
+    GLuint objectId = 0;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pick.PBO);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), &objectId);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteSync(pick.fence);
+    pick.fence = nullptr;
+
+    result.objectId = objectId;
+    result.clickTime = pick.clickTime;
+    result.frameTime = pick.frameTime;
+    pendingHead = (pendingHead + 1) % MAX_PENDING;
+    pendingCount--;
+    return true;
+}
\ No newline at end of file
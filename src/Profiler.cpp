@@ -0,0 +1,332 @@
+#include "../inc/Profiler.h"
+#include "../inc/RenderStats.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    // overlay layout, top right corner of the screen
+    const float OVERLAY_WIDTH = 420.0f;
+    const float GRAPH_HEIGHT = 120.0f;
+    const float GRAPH_MAX_MS = 33.3f;   // top of the graph
+    const float BUDGET_MS = 1000.0f / 144.0f;
+    const glm::vec3 TEXT_COLOR(0.0f, 0.0f, 0.0f);
+    const glm::vec3 GRAPH_COLOR(0.8f, 0.0f, 0.0f);
+    const glm::vec3 BUDGET_COLOR(0.0f, 0.6f, 0.0f);
+    const double OVERLAY_INTERVAL = 0.25; // seconds between overlay text updates
+    const int AVERAGE_FRAMES = 60;        // section times are averaged over the last frames
+
+    float toMs(const std::chrono::steady_clock::duration &duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+}
+
+Profiler::Scope::Scope(Profiler &profiler, const int &section)
+    : profiler(profiler)
+{
+    this->section = section;
+    profiler.begin(section);
+}
+
+Profiler::Scope::~Scope()
+{
+    profiler.end(section);
+}
+
+Profiler::Profiler(const Shader &lineShader, MyPrinter &printer, const unsigned int &screenWidth, const unsigned int &screenHeight)
+    : printer(printer), lineShader(lineShader)
+{
+    this->screenWidth = screenWidth;
+    this->screenHeight = screenHeight;
+    frameIndex = 0;
+    recordStart = 0;
+    recording = false;
+    visible = false;
+    current = FrameRecord{};
+    std::fill(std::begin(history), std::end(history), FrameRecord{});
+    for (auto &bufferFrames : queryFrame)
+    {
+        std::fill(std::begin(bufferFrames), std::end(bufferFrames), -1);
+    }
+    querying = false;
+    VBO = VAO = 0;
+
+    float left = screenWidth - OVERLAY_WIDTH;
+    float top = screenHeight - 40.0f;
+    frameText = printer.createText(left, top, 0.45f, TEXT_COLOR);
+    drawCallText = printer.createText(left, top - 20.0f, 0.45f, TEXT_COLOR);
+}
+
+Profiler::~Profiler()
+{
+    if (VAO == 0) return;
+    for (auto &bufferQueries : queries)
+    {
+        glDeleteQueries(MAX_SECTIONS, bufferQueries);
+    }
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+}
+
+void Profiler::init()
+{
+    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+
+    for (auto &bufferQueries : queries)
+    {
+        glGenQueries(MAX_SECTIONS, bufferQueries);
+    }
+
+    glGenBuffers(1, &VBO);
+    glGenVertexArrays(1, &VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(graphVertices), NULL, GL_DYNAMIC_DRAW);
+    glBindVertexArray(VAO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    glm::mat4 projection = glm::ortho(0.0f, static_cast<GLfloat>(screenWidth), 0.0f, static_cast<GLfloat>(screenHeight));
+    lineShader.use();
+    lineShader.setMat4("projection", projection);
+    glUseProgram(NULL);
+    colorUniform = lineShader.uniform("color");
+
+    lastFrameEnd = Clock::now();
+    lastOverlayUpdate = lastFrameEnd;
+}
+
+int Profiler::addSection(const std::string &name)
+{
+    if ((int)sections.size() == MAX_SECTIONS)
+    {
+        std::cout << "Profiler: too many sections, " << name << " is not timed" << std::endl;
+        return -1;
+    }
+    Section section;
+    section.name = name;
+    section.textId = printer.createText(screenWidth - OVERLAY_WIDTH, screenHeight - 60.0f - 20.0f * sections.size(), 0.45f, TEXT_COLOR);
+    sections.push_back(section);
+    return sections.size() - 1;
+}
+
+void Profiler::beginFrame()
+{
+    // this query set was issued QUERY_BUFFERS frames ago
+    resolveQueries(frameIndex % QUERY_BUFFERS);
+
+    current = FrameRecord{};
+    std::fill(std::begin(current.gpuMs), std::end(current.gpuMs), -1.0f);
+}
+
+void Profiler::endFrame()
+{
+    // from the end of the previous frame, so swap and vsync waits are included
+    Clock::time_point now = Clock::now();
+    current.frameMs = toMs(now - lastFrameEnd);
+    lastFrameEnd = now;
+
+    history[frameIndex % HISTORY] = current;
+    if (recording && recorded.size() < (size_t)MAX_RECORDED) recorded.push_back(current);
+    frameIndex++;
+
+    if (visible && std::chrono::duration<double>(now - lastOverlayUpdate).count() > OVERLAY_INTERVAL)
+    {
+        lastOverlayUpdate = now;
+        updateOverlay();
+    }
+}
+
+void Profiler::begin(const int &section)
+{
+    if (section < 0) return;
+    sections[section].cpuStart = Clock::now();
+    // a query whose result is still pending would lose it when issued again,
+    // this frame goes without a gpu time for the section instead
+    int buffer = frameIndex % QUERY_BUFFERS;
+    querying = queryFrame[buffer][section] < 0;
+    if (!querying) return;
+    glBeginQuery(GL_TIME_ELAPSED, queries[buffer][section]);
+    queryFrame[buffer][section] = frameIndex;
+}
+
+void Profiler::end(const int &section)
+{
+    if (section < 0) return;
+    if (querying) glEndQuery(GL_TIME_ELAPSED);
+    querying = false;
+    current.cpuMs[section] += toMs(Clock::now() - sections[section].cpuStart);
+}
+
+// read the results that are ready, the ones that are not are checked again
+// the next time this set comes around instead of waited for
+void Profiler::resolveQueries(const int &buffer)
+{
+    for (int i = 0; i < (int)sections.size(); i++)
+    {
+        if (queryFrame[buffer][i] < 0) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(queries[buffer][i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(queries[buffer][i], GL_QUERY_RESULT, &elapsed);
+        storeGpuTime(queryFrame[buffer][i], i, elapsed / 1.0e6f);
+        queryFrame[buffer][i] = -1;
+    }
+}
+
+void Profiler::storeGpuTime(const long long &frame, const int &section, const float &ms)
+{
+    if (frame > frameIndex - HISTORY) history[frame % HISTORY].gpuMs[section] = ms;
+    long long index = frame - recordStart;
+    if (recording && index >= 0 && index < (long long)recorded.size()) recorded[index].gpuMs[section] = ms;
+}
+
+void Profiler::setVisible(const bool &visible)
+{
+    if (this->visible == visible) return;
+    this->visible = visible;
+    if (visible) updateOverlay();
+    else clearOverlay();
+}
+
+bool Profiler::isVisible() const
+{
+    return visible;
+}
+
+void Profiler::updateOverlay()
+{
+    int frames = (int)std::min<long long>(frameIndex, HISTORY);
+    if (frames == 0) return;
+
+    float frameMs[HISTORY];
+    for (int i = 0; i < frames; i++)
+    {
+        frameMs[i] = history[i].frameMs;
+    }
+    auto percentile = [&](const float &p) {
+        int index = std::min(frames - 1, (int)(p * frames));
+        std::nth_element(frameMs, frameMs + index, frameMs + frames);
+        return frameMs[index];
+    };
+    float p50 = percentile(0.5f);
+    float p99 = percentile(0.99f);
+    float max = *std::max_element(frameMs, frameMs + frames);
+    printer.setText(frameText, "Frame ms    p50 {:.2f}  p99 {:.2f}  max {:.2f}", p50, p99, max);
+    printer.setText(drawCallText, "Draw calls  {:d}  triangles {:d}", RenderStats::drawCalls, RenderStats::triangles);
+
+    int averaged = std::min(frames, AVERAGE_FRAMES);
+    for (int s = 0; s < (int)sections.size(); s++)
+    {
+        float cpu = 0, gpu = 0;
+        int gpuFrames = 0;
+        for (int i = 1; i <= averaged; i++)
+        {
+            const FrameRecord &record = history[(frameIndex - i) % HISTORY];
+            cpu += record.cpuMs[s];
+            if (record.gpuMs[s] < 0) continue;
+            gpu += record.gpuMs[s];
+            gpuFrames++;
+        }
+        printer.setText(sections[s].textId, "{:<12}cpu {:.3f}  gpu {:.3f} ms", sections[s].name, cpu / averaged, gpuFrames ? gpu / gpuFrames : 0.0f);
+    }
+}
+
+void Profiler::clearOverlay()
+{
+    printer.setText(frameText, std::string_view());
+    printer.setText(drawCallText, std::string_view());
+    for (auto &section : sections)
+    {
+        printer.setText(section.textId, std::string_view());
+    }
+}
+
+void Profiler::renderOverlay()
+{
+    if (!visible) return;
+    renderGraph();
+}
+
+// oldest frame on the left, newest on the right
+void Profiler::renderGraph()
+{
+    float left = screenWidth - OVERLAY_WIDTH;
+    float bottom = screenHeight - 80.0f - 20.0f * sections.size() - GRAPH_HEIGHT;
+    float step = (OVERLAY_WIDTH - 20.0f) / (HISTORY - 1);
+    for (int i = 0; i < HISTORY; i++)
+    {
+        long long frame = frameIndex - HISTORY + i;
+        float ms = frame >= 0 ? history[frame % HISTORY].frameMs : 0.0f;
+        graphVertices[i * 2] = left + step * i;
+        graphVertices[i * 2 + 1] = bottom + GRAPH_HEIGHT * std::min(ms / GRAPH_MAX_MS, 1.0f);
+    }
+    float budgetY = bottom + GRAPH_HEIGHT * BUDGET_MS / GRAPH_MAX_MS;
+    graphVertices[HISTORY * 2] = left;
+    graphVertices[HISTORY * 2 + 1] = budgetY;
+    graphVertices[HISTORY * 2 + 2] = left + step * (HISTORY - 1);
+    graphVertices[HISTORY * 2 + 3] = budgetY;
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(graphVertices), graphVertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    lineShader.use();
+    glBindVertexArray(VAO);
+    lineShader.setVec3(colorUniform, GRAPH_COLOR);
+    glDrawArrays(GL_LINE_STRIP, 0, HISTORY);
+    RenderStats::addDraw(0);
+    lineShader.setVec3(colorUniform, BUDGET_COLOR);
+    glDrawArrays(GL_LINES, HISTORY, 2);
+    RenderStats::addDraw(0);
+    glBindVertexArray(0);
+    glUseProgram(NULL);
+}
+
+void Profiler::startRecording()
+{
+    if (recording) return;
+    recording = true;
+    recordStart = frameIndex;
+    recorded.reserve(1 << 16);
+}
+
+// csv, one row per frame, -1 where the gpu time was not ready in time
+bool Profiler::dump(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "Profiler: failed to open " << path << std::endl;
+        return false;
+    }
+    out << "frame,frame_ms";
+    for (const auto &section : sections)
+    {
+        out << "," << section.name << "_cpu_ms," << section.name << "_gpu_ms";
+    }
+    out << "\n";
+    for (size_t i = 0; i < recorded.size(); i++)
+    {
+        const FrameRecord &record = recorded[i];
+        out << recordStart + i << "," << record.frameMs;
+        for (size_t s = 0; s < sections.size(); s++)
+        {
+            out << "," << record.cpuMs[s] << "," << record.gpuMs[s];
+        }
+        out << "\n";
+    }
+    std::cout << "Profiler: " << recorded.size() << " frames written to " << path << std::endl;
+    return true;
+}
\ No newline at end of file
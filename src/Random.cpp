@@ -0,0 +1,73 @@
+#include "../inc/Random.h"
+
+#include <random>
+
+namespace {
+    std::uint64_t rotl(const std::uint64_t &x, const int &k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t splitmix64(std::uint64_t &x)
+    {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+}
+
+Random::Random(const std::uint64_t &seed/* = 0*/)
+{
+    this->seed(seed);
+}
+
+void Random::seed(const std::uint64_t &seed)
+{
+    std::uint64_t x = seed;
+    for (auto &word : state)
+    {
+        word = splitmix64(x);
+    }
+}
+
+std::uint64_t Random::next()
+{
+    const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+}
+
+// Lemire's multiply and reject, unbiased without a division in the common case
+std::uint32_t Random::below(const std::uint32_t &bound)
+{
+    std::uint64_t m = (next() >> 32) * bound;
+    std::uint32_t low = (std::uint32_t)m;
+    if (low < bound)
+    {
+        std::uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            m = (next() >> 32) * bound;
+            low = (std::uint32_t)m;
+        }
+    }
+    return (std::uint32_t)(m >> 32);
+}
+
+float Random::nextFloat()
+{
+    return (next() >> 40) * (1.0f / (1 << 24));
+}
+
+std::uint64_t Random::randomSeed()
+{
+    std::random_device device;
+    return ((std::uint64_t)device() << 32) ^ device();
+}
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include "../inc/RawMouse.h"
+
+#include <iostream>
+
+#include <GLFW/glfw3.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <future>
+#elif defined(__linux__)
+#include <filesystem>
+#include <linux/input.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <cerrno>
+#endif
+
+RawMouse::RawMouse()
+{
+    running = false;
+    dropped = 0;
+    queued = 0;
+#ifdef _WIN32
+    threadId = 0;
+#else
+    fd = -1;
+#endif
+}
+
+RawMouse::~RawMouse()
+{
+    stop();
+}
+
+void RawMouse::push(const InputEvent &event)
+{
+    // the game is far behind if this fails, dropping is better than blocking
+    if (!events.push(event)) dropped++;
+    else queued.fetch_add(1, std::memory_order_release);
+}
+
+// after the thread was joined
+void RawMouse::reportDropped()
+{
+    if (dropped > 0) std::cout << "RawMouse: event queue was full, " << dropped << " events dropped" << std::endl;
+    dropped = 0;
+}
+
+bool RawMouse::pop(InputEvent &event)
+{
+    return events.pop(event);
+}
+
+bool RawMouse::peek(InputEvent &event) const
+{
+    return events.peek(event);
+}
+
+std::uint64_t RawMouse::queuedCount() const
+{
+    return queued.load(std::memory_order_acquire);
+}
+
+#ifdef _WIN32
+
+bool RawMouse::start()
+{
+    if (running) return true;
+    // the message-only window has to be created by the thread that pumps its messages
+    std::promise<bool> ready;
+    std::future<bool> result = ready.get_future();
+    running = true;
+    thread = std::thread([this, &ready]() {
+        threadId = GetCurrentThreadId();
+        HINSTANCE instance = GetModuleHandleW(NULL);
+        WNDCLASSEXW windowClass = {};
+        windowClass.cbSize = sizeof(windowClass);
+        windowClass.lpfnWndProc = DefWindowProcW;
+        windowClass.hInstance = instance;
+        windowClass.lpszClassName = L"Aim1abRawMouse";
+        RegisterClassExW(&windowClass);
+        HWND window = CreateWindowExW(0, windowClass.lpszClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, instance, NULL);
+
+        // generic desktop page, mouse usage; RIDEV_INPUTSINK keeps it coming without focus
+        // note: a process has one registration per device type, so GLFW_RAW_MOUSE_MOTION must stay off
+        RAWINPUTDEVICE device = { 0x01, 0x02, RIDEV_INPUTSINK, window };
+        bool ok = window != NULL && RegisterRawInputDevices(&device, 1, sizeof(device));
+        ready.set_value(ok);
+        if (ok) run();
+        if (window != NULL) DestroyWindow(window);
+        UnregisterClassW(windowClass.lpszClassName, instance);
+    });
+    if (!result.get())
+    {
+        std::cout << "RawMouse: RegisterRawInputDevices failed" << std::endl;
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void RawMouse::run()
+{
+    MSG message;
+    while (running && GetMessageW(&message, NULL, 0, 0) > 0)
+    {
+        if (message.message == WM_INPUT)
+        {
+            Timestamp time = nowMicros();
+            RAWINPUT raw;
+            UINT size = sizeof(raw);
+            if (GetRawInputData((HRAWINPUT)message.lParam, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) != (UINT)-1
+                && raw.header.dwType == RIM_TYPEMOUSE)
+            {
+                const RAWMOUSE &mouse = raw.data.mouse;
+                if (!(mouse.usFlags & MOUSE_MOVE_ABSOLUTE) && (mouse.lLastX != 0 || mouse.lLastY != 0))
+                {
+                    InputEvent event{};
+                    event.type = InputEvent::Type::MOUSE_MOVE;
+                    event.time = time;
+                    event.xOffset = static_cast<float>(mouse.lLastX);
+                    event.yOffset = -static_cast<float>(mouse.lLastY); // 鼠标向下移动时 y 为正
+                    push(event);
+                }
+                if (mouse.usButtonFlags & (RI_MOUSE_LEFT_BUTTON_DOWN | RI_MOUSE_LEFT_BUTTON_UP))
+                {
+                    InputEvent event{};
+                    event.type = InputEvent::Type::MOUSE_BUTTON;
+                    event.time = time;
+                    event.button = GLFW_MOUSE_BUTTON_LEFT;
+                    event.action = (mouse.usButtonFlags & RI_MOUSE_LEFT_BUTTON_DOWN) ? GLFW_PRESS : GLFW_RELEASE;
+                    push(event);
+                }
+            }
+        }
+        DispatchMessageW(&message);
+    }
+}
+
+void RawMouse::stop()
+{
+    if (!thread.joinable()) return;
+    running = false;
+    PostThreadMessageW(threadId, WM_QUIT, 0, 0);
+    thread.join();
+    reportDropped();
+}
+
+#elif defined(__linux__)
+
+namespace {
+    constexpr int BITS_PER_LONG = 8 * sizeof(long);
+
+    bool testBit(const unsigned long *bits, int bit)
+    {
+        return (bits[bit / BITS_PER_LONG] >> (bit % BITS_PER_LONG)) & 1;
+    }
+}
+
+bool RawMouse::start()
+{
+    if (running) return true;
+    // first evdev device with relative x/y and a left button
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator("/dev/input", error))
+    {
+        if (entry.path().filename().string().rfind("event", 0) != 0) continue;
+        int device = open(entry.path().c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (device < 0) continue;
+
+        unsigned long relBits[REL_MAX / BITS_PER_LONG + 1] = {};
+        unsigned long keyBits[KEY_MAX / BITS_PER_LONG + 1] = {};
+        ioctl(device, EVIOCGBIT(EV_REL, sizeof(relBits)), relBits);
+        ioctl(device, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+        if (testBit(relBits, REL_X) && testBit(relBits, REL_Y) && testBit(keyBits, BTN_LEFT))
+        {
+            // kernel timestamps on the same clock as steady_clock
+            int clock = CLOCK_MONOTONIC;
+            ioctl(device, EVIOCSCLOCKID, &clock);
+            fd = device;
+            break;
+        }
+        close(device);
+    }
+    if (fd < 0)
+    {
+        std::cout << "RawMouse: no readable evdev mouse, is the user in the input group?" << std::endl;
+        return false;
+    }
+
+    running = true;
+    thread = std::thread(&RawMouse::run, this);
+    return true;
+}
+
+void RawMouse::run()
+{
+    pollfd target = { fd, POLLIN, 0 };
+    input_event buffer[64];
+    float xOffset = 0, yOffset = 0;
+    // buttons of the report being read, sent after its motion
+    InputEvent buttons[4];
+    int buttonCount = 0;
+    while (running)
+    {
+        // wake up regularly to notice stop()
+        if (poll(&target, 1, 100) <= 0) continue;
+        if (target.revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            std::cout << "RawMouse: mouse device lost, raw input stopped" << std::endl;
+            break;
+        }
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (size_t i = 0; i < length / sizeof(input_event); i++)
+            {
+                const input_event &ev = buffer[i];
+                Timestamp time = (Timestamp)ev.input_event_sec * 1000000 + ev.input_event_usec;
+                if (ev.type == EV_REL && ev.code == REL_X) xOffset += ev.value;
+                else if (ev.type == EV_REL && ev.code == REL_Y) yOffset -= ev.value; // 鼠标向下移动时 y 为正
+                else if (ev.type == EV_KEY && ev.code == BTN_LEFT && ev.value != 2 && buttonCount < 4)
+                {
+                    InputEvent &event = buttons[buttonCount++];
+                    event = InputEvent{};
+                    event.type = InputEvent::Type::MOUSE_BUTTON;
+                    event.time = time;
+                    event.button = GLFW_MOUSE_BUTTON_LEFT;
+                    event.action = ev.value ? GLFW_PRESS : GLFW_RELEASE;
+                }
+                else if (ev.type == EV_SYN && ev.code == SYN_REPORT)
+                {
+                    // one motion event per hardware report, before its clicks so they hit-test the moved aim
+                    if (xOffset != 0 || yOffset != 0)
+                    {
+                        InputEvent event{};
+                        event.type = InputEvent::Type::MOUSE_MOVE;
+                        event.time = time;
+                        event.xOffset = xOffset;
+                        event.yOffset = yOffset;
+                        push(event);
+                        xOffset = yOffset = 0;
+                    }
+                    for (int b = 0; b < buttonCount; b++)
+                    {
+                        push(buttons[b]);
+                    }
+                    buttonCount = 0;
+                }
+            }
+        }
+        // ENODEV once the device is unplugged, polling it again would spin
+        if (length < 0 && errno != EAGAIN && errno != EINTR)
+        {
+            std::cout << "RawMouse: reading the mouse device failed, raw input stopped" << std::endl;
+            break;
+        }
+    }
+}
+
+void RawMouse::stop()
+{
+    running = false;
+    if (thread.joinable()) thread.join();
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    reportDropped();
+}
+
+#else
+
+bool RawMouse::start()
+{
+    std::cout << "RawMouse: not supported on this platform" << std::endl;
+    return false;
+}
+
+void RawMouse::run()
+{
+}
+
+void RawMouse::stop()
+{
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "../inc/RenderStats.h"
+
+unsigned int RenderStats::drawCalls = 0;
+unsigned int RenderStats::triangles = 0;
+
+void RenderStats::reset()
+{
+    drawCalls = 0;
+    triangles = 0;
+}
+
+void RenderStats::addDraw(const unsigned int &triangleCount)
+{
+    drawCalls++;
+    triangles += triangleCount;
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "../inc/SessionArchive.h"
+#include "../inc/Camera.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::uint64_t alignUp(const std::uint64_t &offset)
+    {
+        return (offset + SessionArchive::ALIGNMENT - 1) / SessionArchive::ALIGNMENT * SessionArchive::ALIGNMENT;
+    }
+
+    // pads the file to the next column boundary, returns the column's offset
+    template <class T>
+    std::uint64_t writeColumn(std::ofstream &out, const std::vector<T> &values)
+    {
+        std::uint64_t offset = alignUp(out.tellp());
+        while ((std::uint64_t)out.tellp() < offset) out.put(0);
+        out.write((const char *)values.data(), values.size() * sizeof(T));
+        return offset;
+    }
+
+    // count elements inside the file and the column on an ALIGNMENT boundary,
+    // written without a sum that a corrupt offset could wrap around
+    bool columnFits(const std::uint64_t &offset, const std::uint64_t &count, const std::size_t &elementSize, const std::size_t &fileSize)
+    {
+        return offset % SessionArchive::ALIGNMENT == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+    }
+}
+
+bool ArchiveWriter::addSession(const std::string &player, SessionReader &reader)
+{
+    const SessionLog::Header &header = reader.getHeader();
+    Session session{};
+    SessionArchive::SessionEntry &entry = session.entry;
+    std::strncpy(entry.player, player.c_str(), SessionArchive::PLAYER_NAME_SIZE - 1);
+    entry.seed = header.seed;
+    entry.gameMode = header.gameMode;
+    entry.hitMode = header.hitMode;
+
+    // view direction at each target's spawn, for the flick of the hit that follows
+    glm::vec3 front = Camera::frontFromAngles(header.cameraYaw, header.cameraPitch);
+    std::map<int, glm::vec3> spawnFronts;
+    bool started = false;
+
+    SessionLog::RecordType type;
+    const char *payload;
+    reader.rewind();
+    while (reader.next(type, payload))
+    {
+        std::int64_t time;
+        std::memcpy(&time, payload, sizeof(time)); // every record starts with its time
+        entry.endTime = std::max(entry.endTime, time);
+        if (type == SessionLog::RecordType::START)
+        {
+            entry.startTime = time;
+            started = true;
+        }
+        else if (type == SessionLog::RecordType::CAMERA)
+        {
+            // poses are recorded once per update, at most a millisecond behind a click
+            SessionLog::Camera record;
+            std::memcpy(&record, payload, sizeof(record));
+            front = Camera::frontFromAngles(record.yaw, record.pitch);
+        }
+        else if (type == SessionLog::RecordType::SPAWN)
+        {
+            SessionLog::Spawn record;
+            std::memcpy(&record, payload, sizeof(record));
+            spawnFronts[record.target] = front;
+        }
+        else if (type == SessionLog::RecordType::HIT)
+        {
+            SessionLog::Hit record;
+            std::memcpy(&record, payload, sizeof(record));
+            session.clickTimes.push_back(record.time - entry.startTime);
+            session.clickHits.push_back(1);
+            session.killTimes.push_back(record.reactionTime);
+            auto spawnFront = spawnFronts.find(record.target);
+            float cosine = spawnFront == spawnFronts.end() ? 1.0f : glm::clamp(glm::dot(spawnFront->second, front), -1.0f, 1.0f);
+            session.flicks.push_back(glm::degrees(std::acos(cosine)));
+        }
+        else if (type == SessionLog::RecordType::MISS)
+        {
+            SessionLog::Miss record;
+            std::memcpy(&record, payload, sizeof(record));
+            session.clickTimes.push_back(record.time - entry.startTime);
+            session.clickHits.push_back(0);
+        }
+    }
+    if (!started) return false;
+
+    entry.clickCount = session.clickTimes.size();
+    entry.hitCount = session.killTimes.size();
+    sessions.push_back(std::move(session));
+    return true;
+}
+
+int ArchiveWriter::sessionCount() const
+{
+    return sessions.size();
+}
+
+bool ArchiveWriter::write(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::cout << "Failed to open archive " << path << " for writing" << std::endl;
+        return false;
+    }
+    SessionArchive::Header header{};
+    header.magic = SessionArchive::MAGIC;
+    header.version = SessionArchive::VERSION;
+    header.sessionCount = sessions.size();
+    out.write((const char *)&header, sizeof(header));
+
+    std::vector<SessionArchive::SessionEntry> index;
+    for (const auto &session : sessions)
+    {
+        SessionArchive::SessionEntry entry = session.entry;
+        entry.clickTimeOffset = writeColumn(out, session.clickTimes);
+        entry.clickHitOffset = writeColumn(out, session.clickHits);
+        entry.killTimeOffset = writeColumn(out, session.killTimes);
+        entry.flickOffset = writeColumn(out, session.flicks);
+        index.push_back(entry);
+    }
+    header.indexOffset = writeColumn(out, index);
+    header.fileSize = out.tellp();
+    out.seekp(0);
+    out.write((const char *)&header, sizeof(header));
+    if (!out)
+    {
+        std::cout << "Failed to write archive " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+MappedArchive::MappedArchive()
+{
+    data = nullptr;
+    size = 0;
+#ifdef _WIN32
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+#else
+    fd = -1;
+#endif
+}
+
+MappedArchive::~MappedArchive()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedArchive::open(const std::string &path)
+{
+    close();
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    LARGE_INTEGER fileSize;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        std::cout << "Failed to open archive " << path << std::endl;
+        close();
+        return false;
+    }
+    size = fileSize.QuadPart;
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL) data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        std::cout << "Failed to map archive " << path << std::endl;
+        close();
+        return false;
+    }
+    if (!validate(path))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedArchive::close()
+{
+    if (data != nullptr) UnmapViewOfFile(data);
+    if (mapping != NULL) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    data = nullptr;
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+    size = 0;
+}
+
+#else
+
+bool MappedArchive::open(const std::string &path)
+{
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) != 0 || status.st_size == 0)
+    {
+        std::cout << "Failed to open archive " << path << std::endl;
+        close();
+        return false;
+    }
+    size = status.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        std::cout << "Failed to map archive " << path << std::endl;
+        close();
+        return false;
+    }
+    data = (const char *)mapped;
+    // columns are scanned front to back
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    if (!validate(path))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedArchive::close()
+{
+    if (data != nullptr) munmap((void *)data, size);
+    if (fd >= 0) ::close(fd);
+    data = nullptr;
+    fd = -1;
+    size = 0;
+}
+
+#endif
+
+// the header and every column must lie inside the file, aligned
+bool MappedArchive::validate(const std::string &path) const
+{
+    if (size < sizeof(SessionArchive::Header) || getHeader().magic != SessionArchive::MAGIC || getHeader().version != SessionArchive::VERSION)
+    {
+        std::cout << "Not an archive of version " << SessionArchive::VERSION << ": " << path << std::endl;
+        return false;
+    }
+    const SessionArchive::Header &header = getHeader();
+    if (header.fileSize != size || !columnFits(header.indexOffset, header.sessionCount, sizeof(SessionArchive::SessionEntry), size))
+    {
+        std::cout << "Archive is truncated: " << path << std::endl;
+        return false;
+    }
+    for (int i = 0; i < sessionCount(); i++)
+    {
+        const SessionArchive::SessionEntry &entry = getSession(i);
+        if (!columnFits(entry.clickTimeOffset, entry.clickCount, sizeof(std::int64_t), size)
+            || !columnFits(entry.clickHitOffset, entry.clickCount, sizeof(std::uint8_t), size)
+            || !columnFits(entry.killTimeOffset, entry.hitCount, sizeof(std::int64_t), size)
+            || !columnFits(entry.flickOffset, entry.hitCount, sizeof(float), size))
+        {
+            std::cout << "Archive session " << i << " is out of bounds: " << path << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+const SessionArchive::Header &MappedArchive::getHeader() const
+{
+    return *reinterpret_cast<const SessionArchive::Header *>(data);
+}
+
+int MappedArchive::sessionCount() const
+{
+    return getHeader().sessionCount;
+}
+
+const SessionArchive::SessionEntry &MappedArchive::getSession(const int &i) const
+{
+    return column<SessionArchive::SessionEntry>(getHeader().indexOffset)[i];
+}
\ No newline at end of file
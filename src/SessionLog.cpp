@@ -0,0 +1,60 @@
+#include "../inc/SessionLog.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+SessionReader::SessionReader()
+{
+    header = {};
+    offset = 0;
+}
+
+bool SessionReader::open(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        std::cout << "Failed to open session " << path << std::endl;
+        return false;
+    }
+    data.resize(in.tellg());
+    in.seekg(0);
+    in.read(data.data(), data.size());
+
+    if (data.size() < sizeof(header))
+    {
+        std::cout << "Not a session file: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != SessionLog::MAGIC || header.version != SessionLog::VERSION)
+    {
+        std::cout << "Not a session file of version " << SessionLog::VERSION << ": " << path << std::endl;
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+const SessionLog::Header &SessionReader::getHeader() const
+{
+    return header;
+}
+
+bool SessionReader::next(SessionLog::RecordType &type, const char *&payload)
+{
+    if (offset >= data.size()) return false;
+    type = (SessionLog::RecordType)data[offset];
+    std::size_t size = SessionLog::payloadSize(type);
+    // a session cut off by a crash ends with a partial record
+    if (size == 0 || offset + 1 + size > data.size()) return false;
+    payload = data.data() + offset + 1;
+    offset += 1 + size;
+    return true;
+}
+
+void SessionReader::rewind()
+{
+    offset = sizeof(header);
+}
\ No newline at end of file
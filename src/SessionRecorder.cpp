@@ -0,0 +1,124 @@
+#include "../inc/SessionRecorder.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+
+SessionRecorder::SessionRecorder()
+{
+    running = false;
+    dropped = 0;
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+bool SessionRecorder::open(const std::string &path, const SessionLog::Header &header)
+{
+    if (running) return true;
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::cout << "Failed to open session " << path << " for recording" << std::endl;
+        return false;
+    }
+    out.write((const char *)&header, sizeof(header));
+    running = true;
+    writer = std::thread(&SessionRecorder::run, this);
+    return true;
+}
+
+void SessionRecorder::close()
+{
+    if (!running.exchange(false)) return;
+    if (writer.joinable()) writer.join();
+    drain();
+    out.close();
+    if (dropped > 0) std::cout << "SessionRecorder: " << dropped << " records dropped" << std::endl;
+}
+
+bool SessionRecorder::isOpen() const
+{
+    return running;
+}
+
+void SessionRecorder::run()
+{
+    while (running.load(std::memory_order_acquire))
+    {
+        drain();
+        // a few ms of records at a time, the queue holds far more than that
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+void SessionRecorder::drain()
+{
+    Entry entry;
+    while (entries.pop(entry))
+    {
+        out.put((char)entry.type);
+        out.write(entry.payload, SessionLog::payloadSize(entry.type));
+    }
+    out.flush();
+}
+
+template <class T>
+void SessionRecorder::push(const SessionLog::RecordType &type, const T &record)
+{
+    static_assert(sizeof(T) <= SessionLog::MAX_PAYLOAD_SIZE, "record larger than an entry");
+    if (!running.load(std::memory_order_relaxed)) return;
+    Entry entry;
+    entry.type = type;
+    std::memcpy(entry.payload, &record, sizeof(T));
+    if (!entries.push(entry)) dropped++;
+}
+
+void SessionRecorder::recordStart(const Timestamp &time)
+{
+    push(SessionLog::RecordType::START, SessionLog::Start{ time });
+}
+
+void SessionRecorder::recordInput(const InputEvent &event)
+{
+    SessionLog::Input record;
+    record.time = event.time;
+    record.type = (std::uint8_t)event.type;
+    record.xOffset = event.xOffset;
+    record.yOffset = event.yOffset;
+    record.button = event.button;
+    record.action = event.action;
+    push(SessionLog::RecordType::INPUT, record);
+}
+
+void SessionRecorder::recordPick(const Timestamp &clickTime, const Timestamp &frameTime, const Timestamp &handledTime, const std::uint32_t &objectId)
+{
+    push(SessionLog::RecordType::PICK, SessionLog::Pick{ clickTime, frameTime, handledTime, objectId });
+}
+
+void SessionRecorder::recordCamera(const Timestamp &time, const glm::vec3 &position, const double &yaw, const double &pitch)
+{
+    push(SessionLog::RecordType::CAMERA, SessionLog::Camera{ time, { position.x, position.y, position.z }, (float)yaw, (float)pitch });
+}
+
+void SessionRecorder::recordSpawn(const Timestamp &time, const int &target, const int &cell)
+{
+    push(SessionLog::RecordType::SPAWN, SessionLog::Spawn{ time, (std::uint32_t)target, cell });
+}
+
+void SessionRecorder::recordHit(const Timestamp &time, const int &target, const Timestamp &reactionTime)
+{
+    push(SessionLog::RecordType::HIT, SessionLog::Hit{ time, (std::uint32_t)target, reactionTime });
+}
+
+void SessionRecorder::recordMiss(const Timestamp &time)
+{
+    push(SessionLog::RecordType::MISS, SessionLog::Miss{ time });
+}
+
+void SessionRecorder::recordUpdate(const Timestamp &time)
+{
+    push(SessionLog::RecordType::UPDATE, SessionLog::Update{ time });
+}
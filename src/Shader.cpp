@@ -1,6 +1,41 @@
 #include "../inc/Shader.h"
 #include "magic_enum.hpp"
 #include <filesystem>
+#include <cstdio>
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace {
+    // the GL 3.3 loader doesn't have the program binary entry points, they are looked up by enableProgramCache()
+    typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+    typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+    typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+    GetProgramBinaryProc getProgramBinary = nullptr;
+    ProgramBinaryProc programBinary = nullptr;
+    ProgramParameteriProc programParameteri = nullptr;
+
+    const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    // at the start of every cache file
+    struct ProgramCacheHeader {
+        std::uint32_t magic;
+        std::uint32_t binaryFormat;
+        std::uint64_t key;
+    };
+    const std::uint32_t PROGRAM_CACHE_MAGIC = 0x4250314A; // "J1PB"
+}
+
+std::string Shader::programCacheDirectory;
+std::uint64_t Shader::driverHash = 0;
 
 Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath)
 {
@@ -14,6 +49,50 @@ Shader::~Shader()
     glDeleteProgram(ID);
 }
 
+void Shader::enableProgramCache(const std::string &directory, GLADloadproc load)
+{
+    if (glGetError() == GL_INVALID_OPERATION)
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+    GLint major = 0, minor = 0, extensionCount = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    bool supported = major > 4 || (major == 4 && minor >= 1);
+    for (GLint i = 0; i < extensionCount && !supported; i++)
+    {
+        supported = std::string((const char *)glGetStringi(GL_EXTENSIONS, i)) == "GL_ARB_get_program_binary";
+    }
+    GLint formatCount = 0;
+    if (supported) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount > 0)
+    {
+        getProgramBinary = (GetProgramBinaryProc)load("glGetProgramBinary");
+        programBinary = (ProgramBinaryProc)load("glProgramBinary");
+        programParameteri = (ProgramParameteriProc)load("glProgramParameteri");
+    }
+    if (getProgramBinary == nullptr || programBinary == nullptr || programParameteri == nullptr)
+    {
+        std::cout << "Program binaries are not supported, shaders are compiled on every launch" << std::endl;
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        std::cout << "Failed to create the shader cache " << directory << ": " << error.message() << std::endl;
+        return;
+    }
+    // a binary is only valid for the driver that made it
+    std::string driver = std::string((const char *)glGetString(GL_VENDOR)) + "\n"
+        + (const char *)glGetString(GL_RENDERER) + "\n" + (const char *)glGetString(GL_VERSION);
+    driverHash = fnv1a(driver, FNV_OFFSET);
+    programCacheDirectory = directory;
+}
+
 void Shader::init()
 {
     if (glGetError() == GL_INVALID_OPERATION)
@@ -22,66 +101,172 @@ void Shader::init()
         throw "The OpenGL context was not created";
     }
     // 1. retrieve the vertex/fragment source code from filePath
-    std::string vertexFileName = std::filesystem::path(vertexPath).filename().string();
-    std::string fragmentFileName = std::filesystem::path(fragmentPath).filename().string();
     std::string vertexCode_s, fragmentCode_s;
-    std::ifstream vertexFile, fragmentFile;
+    readSource(vertexPath, vertexCode_s);
+    readSource(fragmentPath, fragmentCode_s);
+
+    // 2. the program linked by an earlier launch, or compile shaders
+    bool linked = false;
+    std::string cachePath = programCachePath(vertexCode_s, fragmentCode_s);
+    if (!cachePath.empty()) linked = loadCachedProgram(cachePath, ID);
+    if (!linked)
+    {
+        ID = buildProgram(vertexCode_s, fragmentCode_s, linked);
+        if (linked && !cachePath.empty()) storeCachedProgram(cachePath, ID);
+    }
+
+    loadUniformLocations();
+    hasInit = true;
+}
+
+bool Shader::reload()
+{
+    if (!hasInit) return false;
+    std::string vertexCode_s, fragmentCode_s;
+    if (!readSource(vertexPath, vertexCode_s) || !readSource(fragmentPath, fragmentCode_s)) return false;
+
+    bool linked;
+    GLuint program = buildProgram(vertexCode_s, fragmentCode_s, linked);
+    if (!linked)
+    {
+        // keep drawing with the old program until the source is fixed
+        glDeleteProgram(program);
+        std::cout << "Shader reload failed, keeping the previous program: "
+            << std::filesystem::path(vertexPath).filename().string() << " / "
+            << std::filesystem::path(fragmentPath).filename().string() << std::endl;
+        return false;
+    }
+
+    // values set once at init, like projections and sampler units, survive the swap
+    copyUniforms(ID, program);
+    glDeleteProgram(ID);
+    ID = program;
+    loadUniformLocations();
+    warnedNames.clear();
+    std::cout << "Shader reloaded: "
+        << std::filesystem::path(vertexPath).filename().string() << " / "
+        << std::filesystem::path(fragmentPath).filename().string() << std::endl;
+    return true;
+}
+
+bool Shader::readSource(const std::string &path, std::string &code)
+{
+    std::string fileName = std::filesystem::path(path).filename().string();
+    std::ifstream file;
     // ensure ifstream objects can throw exceptions:
-    vertexFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fragmentFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
     // read file
     try
     {
         // open files
-        vertexFile.open(vertexPath);
+        file.open(path);
         // read file's buffer contents into streams
-        std::stringstream vertexStream;
-        vertexStream << vertexFile.rdbuf();
+        std::stringstream stream;
+        stream << file.rdbuf();
         // close file
-        vertexFile.close();
+        file.close();
         // convert stream into string
-        vertexCode_s = vertexStream.str();
-        if (vertexCode_s.length() > 0)
-        {
-            std::cout << "Shader file: " << vertexFileName << " Successfully read" << std::endl;
-        }
-        else
-        {
-            std::cout << "Shader file: " << vertexFileName << " Read fail" << std::endl;
-        }
+        code = stream.str();
+        if (code.length() > 0) return true;
+        std::cout << "Shader file: " << fileName << " Read fail" << std::endl;
     }
     catch (const std::ifstream::failure &e)
     {
-        std::cout << "ERROR::SHADER::FILE_READ_FAILURE in file " << vertexFileName << " : " << e.what() << std::endl;
+        std::cout << "ERROR::SHADER::FILE_READ_FAILURE in file " << fileName << " : " << e.what() << std::endl;
     }
+    return false;
+}
 
-    try
+std::uint64_t Shader::fnv1a(const std::string &data, std::uint64_t hash)
+{
+    for (unsigned char c : data)
     {
-        // open files
-        fragmentFile.open(fragmentPath);
-        // read file's buffer contents into streams
-        std::stringstream fragmentStream;
-        fragmentStream << fragmentFile.rdbuf();
-        // close file
-        fragmentFile.close();
-        // convert stream into string
-        fragmentCode_s = fragmentStream.str();
-        if (fragmentCode_s.length() > 0)
-        {
-            std::cout << "Shader file: " << fragmentFileName << " Successfully read" << std::endl;
-        }
-        else
-        {
-            std::cout << "Shader file: " << fragmentFileName << " Read fail" << std::endl;
-        }
+        hash = (hash ^ c) * FNV_PRIME;
     }
-    catch (const std::ifstream::failure &e)
+    return hash;
+}
+
+std::string Shader::programCachePath(const std::string &vertexCode_s, const std::string &fragmentCode_s) const
+{
+    if (programCacheDirectory.empty()) return std::string();
+    // the separator keeps moving text from one stage to the other from giving the same key
+    std::uint64_t key = fnv1a(fragmentCode_s, fnv1a(std::string(1, '\0'), fnv1a(vertexCode_s, driverHash)));
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return (std::filesystem::path(programCacheDirectory) / name).string();
+}
+
+bool Shader::loadCachedProgram(const std::string &cachePath, GLuint &program) const
+{
+    std::ifstream in(cachePath, std::ios::binary | std::ios::ate);
+    if (!in) return false; // first launch with these sources
+    std::streamoff size = in.tellg();
+    ProgramCacheHeader header;
+    std::vector<char> binary(size > (std::streamoff)sizeof(header) ? size - sizeof(header) : 0);
+    in.seekg(0);
+    in.read((char *)&header, sizeof(header));
+    in.read(binary.data(), binary.size());
+    if (!in || binary.empty() || header.magic != PROGRAM_CACHE_MAGIC
+        || header.key != std::stoull(std::filesystem::path(cachePath).stem().string(), nullptr, 16))
+    {
+        return false;
+    }
+
+    // a driver update can reject binaries of the same version string, then it is compiled again
+    program = glCreateProgram();
+    programBinary(program, header.binaryFormat, binary.data(), (GLsizei)binary.size());
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
     {
-        std::cout << "ERROR::SHADER::FILE_READ_FAILURE in file " << fragmentFileName << " : " << e.what() << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
     }
+    bindFrameData(program);
+    return true;
+}
 
-    // 2. compile shaders
+void Shader::storeCachedProgram(const std::string &cachePath, const GLuint &program) const
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    ProgramCacheHeader header;
+    std::vector<char> binary(length);
+    GLenum binaryFormat = 0;
+    getProgramBinary(program, length, &length, &binaryFormat, binary.data());
+    header.magic = PROGRAM_CACHE_MAGIC;
+    header.binaryFormat = binaryFormat;
+    header.key = std::stoull(std::filesystem::path(cachePath).stem().string(), nullptr, 16);
 
+    // written next to it and renamed, so a launch at the same time never reads half a file
+    std::string temporaryPath = cachePath + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write((const char *)&header, sizeof(header));
+        out.write(binary.data(), length);
+        if (!out)
+        {
+            std::cout << "Failed to write the shader cache " << temporaryPath << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    if (error) std::cout << "Failed to write the shader cache " << cachePath << ": " << error.message() << std::endl;
+}
+
+void Shader::bindFrameData(const GLuint &program)
+{
+    // shared per-frame uniform block
+    GLuint frameDataIndex = glGetUniformBlockIndex(program, "FrameData");
+    if (frameDataIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(program, frameDataIndex, FRAME_DATA_BINDING);
+}
+
+GLuint Shader::buildProgram(const std::string &vertexCode_s, const std::string &fragmentCode_s, bool &linked)
+{
     const char *vertexCode_c = vertexCode_s.c_str();
     const char *fragmentCode_c = fragmentCode_s.c_str();
 
@@ -98,19 +283,159 @@ void Shader::init()
     checkCompileErrors(fragment, CompileType::FRAGMENT);
 
     // shader program
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
-    glLinkProgram(ID);
-    checkCompileErrors(ID, CompileType::PROGRAM);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    if (!programCacheDirectory.empty()) programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+    linked = checkCompileErrors(program, CompileType::PROGRAM);
 
     // delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(vertex);
     glDeleteShader(fragment);
-    hasInit = true;
+
+    bindFrameData(program);
+    return program;
+}
+
+// copies the values of the uniforms both programs have with the same type
+void Shader::copyUniforms(const GLuint &from, const GLuint &to)
+{
+    std::unordered_map<std::string, GLenum> toTypes;
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(to, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(to, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string name(maxLength, '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(to, i, maxLength, &length, &size, &type, name.data());
+        toTypes[name.substr(0, length)] = type;
+    }
+
+    glUseProgram(to);
+    glGetProgramiv(from, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(from, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    name.assign(maxLength, '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(from, i, maxLength, &length, &size, &type, name.data());
+        std::string uniformName = name.substr(0, length);
+        auto toType = toTypes.find(uniformName);
+        if (toType == toTypes.end() || toType->second != type) continue;
+
+        bool isArray = uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0;
+        std::string baseName = isArray ? uniformName.substr(0, uniformName.size() - 3) : uniformName;
+        for (GLint j = 0; j < size; j++)
+        {
+            std::string elementName = isArray ? baseName + "[" + std::to_string(j) + "]" : uniformName;
+            GLint fromLocation = glGetUniformLocation(from, elementName.c_str());
+            GLint toLocation = glGetUniformLocation(to, elementName.c_str());
+            if (fromLocation < 0 || toLocation < 0) continue; // uniform block member or shorter array
+
+            GLfloat f[16];
+            GLint n[4];
+            GLuint u[4];
+            switch (type)
+            {
+            case GL_FLOAT: glGetUniformfv(from, fromLocation, f); glUniform1fv(toLocation, 1, f); break;
+            case GL_FLOAT_VEC2: glGetUniformfv(from, fromLocation, f); glUniform2fv(toLocation, 1, f); break;
+            case GL_FLOAT_VEC3: glGetUniformfv(from, fromLocation, f); glUniform3fv(toLocation, 1, f); break;
+            case GL_FLOAT_VEC4: glGetUniformfv(from, fromLocation, f); glUniform4fv(toLocation, 1, f); break;
+            case GL_FLOAT_MAT3: glGetUniformfv(from, fromLocation, f); glUniformMatrix3fv(toLocation, 1, GL_FALSE, f); break;
+            case GL_FLOAT_MAT4: glGetUniformfv(from, fromLocation, f); glUniformMatrix4fv(toLocation, 1, GL_FALSE, f); break;
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_CUBE:
+                glGetUniformiv(from, fromLocation, n); glUniform1iv(toLocation, 1, n); break;
+            case GL_INT_VEC2: glGetUniformiv(from, fromLocation, n); glUniform2iv(toLocation, 1, n); break;
+            case GL_INT_VEC3: glGetUniformiv(from, fromLocation, n); glUniform3iv(toLocation, 1, n); break;
+            case GL_INT_VEC4: glGetUniformiv(from, fromLocation, n); glUniform4iv(toLocation, 1, n); break;
+            case GL_UNSIGNED_INT: glGetUniformuiv(from, fromLocation, u); glUniform1uiv(toLocation, 1, u); break;
+            default: break;
+            }
+        }
+    }
+    glUseProgram(NULL);
+}
+
+void Shader::loadUniformLocations()
+{
+    uniformLocations.clear();
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string name(maxLength, '\0');
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, i, maxLength, &length, &size, &type, name.data());
+        std::string uniformName = name.substr(0, length);
+        GLint location = glGetUniformLocation(ID, uniformName.c_str());
+        if (location < 0) continue; // uniform block member
+        uniformLocations[uniformName] = location;
+
+        // arrays are reported as "name[0]", also register "name" and the other elements
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+        {
+            std::string baseName = uniformName.substr(0, uniformName.size() - 3);
+            uniformLocations[baseName] = location;
+            for (GLint j = 1; j < size; j++)
+            {
+                std::string elementName = baseName + "[" + std::to_string(j) + "]";
+                uniformLocations[elementName] = glGetUniformLocation(ID, elementName.c_str());
+            }
+        }
+    }
+
+    // refresh the handles already given out
+    for (auto &it : handleSlots)
+    {
+        auto location = uniformLocations.find(it.first);
+        handleLocations[it.second] = location == uniformLocations.end() ? -1 : location->second;
+    }
 }
 
-void Shader::checkCompileErrors(unsigned int shader, CompileType type)
+GLint Shader::getLocation(const std::string &name) const
+{
+    auto it = uniformLocations.find(name);
+    if (it != uniformLocations.end()) return it->second;
+
+    // warn only once, location -1 is silently ignored by glUniform*
+    if (warnedNames.insert(name).second)
+    {
+        std::cout << "WARNING::SHADER::UNKNOWN_UNIFORM: " << name << " in "
+            << std::filesystem::path(vertexPath).filename().string() << " / "
+            << std::filesystem::path(fragmentPath).filename().string() << std::endl;
+    }
+    return -1;
+}
+
+GLint Shader::handleLocation(const UniformHandle &handle) const
+{
+    return handle.slot < 0 ? -1 : handleLocations[handle.slot];
+}
+
+UniformHandle Shader::uniform(const std::string &name) const
+{
+    auto it = handleSlots.find(name);
+    if (it != handleSlots.end()) return UniformHandle{ it->second };
+
+    int slot = handleLocations.size();
+    handleLocations.push_back(getLocation(name));
+    handleSlots.emplace(name, slot);
+    return UniformHandle{ slot };
+}
+
+bool Shader::checkCompileErrors(unsigned int shader, CompileType type)
 {
     int success;
     char infoLog[1024];
@@ -138,6 +463,7 @@ void Shader::checkCompileErrors(unsigned int shader, CompileType type)
                 << LONG_LINE << std::endl;
         }
     }
+    return success;
 }
 
 void Shader::use() const
@@ -155,18 +481,18 @@ void Shader::use() const
 
 void Shader::setBool(const std::string &name, const bool &value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    glUniform1i(getLocation(name), (int)value);
 }
 
 void Shader::setInt(const std::string &name, const int &value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(getLocation(name), value);
 }
 
 
 void Shader::setFloat(const std::string &name, const float &value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1f(getLocation(name), value);
 }
 
 void Shader::setFloatArray(const std::string &firstElementName, const int &index, const float &value) const
@@ -178,37 +504,68 @@ void Shader::setFloatArray(const std::string &firstElementName, const int &index
     else
     {
         secondElementName.replace(indexPos, 3, "[1]");
-        int elementSize = glGetUniformLocation(ID, secondElementName.c_str()) - glGetUniformLocation(ID, firstElementName.c_str());
-        glUniform1f(glGetUniformLocation(ID, firstElementName.c_str()) + index * elementSize, value);
+        int elementSize = getLocation(secondElementName) - getLocation(firstElementName);
+        glUniform1f(getLocation(firstElementName) + index * elementSize, value);
     }
 }
 
 void Shader::setVec3(const std::string &name, const glm::vec3 &vec) const
 {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(vec));
+    glUniform3fv(getLocation(name), 1, glm::value_ptr(vec));
 }
 
 void Shader::setVec3(const std::string &name, const float &x, const float &y, const float &z) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    glUniform3f(getLocation(name), x, y, z);
 }
 
 void Shader::setVec3Array(const std::string &firstElementName, const int &elementSize, const int &index, const glm::vec3 &vec) const
 {
-    glUniform3fv(glGetUniformLocation(ID, firstElementName.c_str()) + index * elementSize, 1, glm::value_ptr(vec));
+    glUniform3fv(getLocation(firstElementName) + index * elementSize, 1, glm::value_ptr(vec));
 }
 
 void Shader::setVec4(const std::string &name, const glm::vec4 &vec) const
 {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(vec));
+    glUniform4fv(getLocation(name), 1, glm::value_ptr(vec));
 }
 
 void Shader::setVec4(const std::string &name, const float &x, const float &y, const float &z, const float &w) const
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    glUniform4f(getLocation(name), x, y, z, w);
 }
 
 void Shader::setMat4(const std::string &name, const glm::mat4 &matrix) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(matrix));
+    glUniformMatrix4fv(getLocation(name), 1, GL_FALSE, glm::value_ptr(matrix));
 }
+
+
+void Shader::setBool(const UniformHandle &handle, const bool &value) const
+{
+    glUniform1i(handleLocation(handle), (int)value);
+}
+
+void Shader::setInt(const UniformHandle &handle, const int &value) const
+{
+    glUniform1i(handleLocation(handle), value);
+}
+
+void Shader::setFloat(const UniformHandle &handle, const float &value) const
+{
+    glUniform1f(handleLocation(handle), value);
+}
+
+void Shader::setVec3(const UniformHandle &handle, const glm::vec3 &vec) const
+{
+    glUniform3fv(handleLocation(handle), 1, glm::value_ptr(vec));
+}
+
+void Shader::setVec4(const UniformHandle &handle, const glm::vec4 &vec) const
+{
+    glUniform4fv(handleLocation(handle), 1, glm::value_ptr(vec));
+}
+
+void Shader::setMat4(const UniformHandle &handle, const glm::mat4 &matrix) const
+{
+    glUniformMatrix4fv(handleLocation(handle), 1, GL_FALSE, glm::value_ptr(matrix));
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "../inc/ShaderWatcher.h"
+
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+const Timestamp ShaderWatcher::SETTLE_TIME = 50000;
+
+ShaderWatcher::ShaderWatcher(const std::string &directory)
+{
+    this->directory = directory;
+    running = false;
+#ifdef __linux__
+    fd = -1;
+#endif
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+    stop();
+}
+
+void ShaderWatcher::add(Shader &shader)
+{
+    shaders.push_back(&shader);
+}
+
+void ShaderWatcher::markChanged(const std::string &fileName)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    changed[fileName] = nowMicros();
+}
+
+int ShaderWatcher::reloadChanged()
+{
+    std::vector<std::string> settled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (changed.empty()) return 0;
+        Timestamp now = nowMicros();
+        for (auto it = changed.begin(); it != changed.end();)
+        {
+            if (now - it->second < SETTLE_TIME)
+            {
+                ++it;
+                continue;
+            }
+            settled.push_back(it->first);
+            it = changed.erase(it);
+        }
+    }
+
+    int reloaded = 0;
+    for (auto shader : shaders)
+    {
+        std::string vertexName = std::filesystem::path(shader->vertexPath).filename().string();
+        std::string fragmentName = std::filesystem::path(shader->fragmentPath).filename().string();
+        for (const auto &fileName : settled)
+        {
+            if (fileName != vertexName && fileName != fragmentName) continue;
+            if (shader->reload()) reloaded++;
+            break;
+        }
+    }
+    return reloaded;
+}
+
+#ifdef __linux__
+
+bool ShaderWatcher::start()
+{
+    if (running) return true;
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // editors either write the file in place or rename a temporary over it
+    if (fd < 0 || inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        std::cout << "ShaderWatcher: can't watch " << directory << std::endl;
+        stop();
+        return false;
+    }
+
+    running = true;
+    thread = std::thread(&ShaderWatcher::run, this);
+    return true;
+}
+
+void ShaderWatcher::run()
+{
+    pollfd target = { fd, POLLIN, 0 };
+    alignas(inotify_event) char buffer[4096];
+    while (running)
+    {
+        // wake up regularly to notice stop()
+        if (poll(&target, 1, 100) <= 0) continue;
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event *event = (const inotify_event *)(buffer + offset);
+                if (event->len > 0) markChanged(event->name);
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+}
+
+void ShaderWatcher::stop()
+{
+    running = false;
+    if (thread.joinable()) thread.join();
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+
+#else
+
+bool ShaderWatcher::start()
+{
+    if (running) return true;
+    if (!std::filesystem::is_directory(directory))
+    {
+        std::cout << "ShaderWatcher: can't watch " << directory << std::endl;
+        return false;
+    }
+
+    running = true;
+    thread = std::thread(&ShaderWatcher::run, this);
+    return true;
+}
+
+// no change notification, compare modification times a few times a second
+void ShaderWatcher::run()
+{
+    std::map<std::string, std::filesystem::file_time_type> writeTimes;
+    bool first = true;
+    while (running)
+    {
+        std::error_code error;
+        for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+        {
+            std::string fileName = entry.path().filename().string();
+            auto writeTime = entry.last_write_time(error);
+            if (error) continue;
+            auto it = writeTimes.find(fileName);
+            if (it != writeTimes.end() && it->second == writeTime) continue;
+            writeTimes[fileName] = writeTime;
+            if (!first) markChanged(fileName);
+        }
+        first = false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+}
+
+void ShaderWatcher::stop()
+{
+    running = false;
+    if (thread.joinable()) thread.join();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "../inc/Simulation.h"
+
+#include <algorithm>
+
+namespace {
+    const float STEP_SECONDS = Simulation::STEP / 1e6f;
+    const float STRAFE_MIN = 0.3f; // seconds
+    const float STRAFE_MAX = 1.2f;
+    const float VERTICAL_RATIO = 0.3f; // vertical speed relative to the horizontal one
+}
+
+Simulation::Simulation(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const float &minSpeed, const float &maxSpeed)
+{
+    this->boundsMin = boundsMin;
+    this->boundsMax = boundsMax;
+    this->minSpeed = minSpeed;
+    this->maxSpeed = maxSpeed;
+    time = 0;
+    started = false;
+}
+
+void Simulation::seed(const std::uint64_t &seed)
+{
+    random.seed(seed);
+}
+
+int Simulation::addTarget(const glm::vec3 &center, const float &radius)
+{
+    int id = targets.add(center, radius);
+    previous.push_back(center);
+    strafeTimer.push_back(0.0f);
+    pickVelocity(id);
+    return id;
+}
+
+int Simulation::size() const
+{
+    return targets.size();
+}
+
+void Simulation::start(const Timestamp &startTime)
+{
+    time = startTime;
+    started = true;
+}
+
+void Simulation::advanceTo(const Timestamp &time)
+{
+    if (!started) return;
+    while (this->time + STEP <= time)
+    {
+        step();
+        this->time += STEP;
+    }
+}
+
+Timestamp Simulation::getTime() const
+{
+    return time;
+}
+
+void Simulation::step()
+{
+    for (int i = 0; i < targets.size(); i++)
+    {
+        previous[i] = targets.getCenter(i);
+    }
+    targets.integrate(STEP_SECONDS);
+
+    for (int i = 0; i < targets.size(); i++)
+    {
+        // bounce off the bounds, the radius stays inside
+        glm::vec3 center = targets.getCenter(i);
+        glm::vec3 velocity = targets.getVelocity(i);
+        float radius = targets.getRadius(i);
+        bool bounced = false;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (center[axis] - radius < boundsMin[axis] && velocity[axis] < 0)
+            {
+                velocity[axis] = -velocity[axis];
+                bounced = true;
+            }
+            else if (center[axis] + radius > boundsMax[axis] && velocity[axis] > 0)
+            {
+                velocity[axis] = -velocity[axis];
+                bounced = true;
+            }
+        }
+        if (bounced) targets.setVelocity(i, velocity);
+
+        strafeTimer[i] -= STEP_SECONDS;
+        if (strafeTimer[i] <= 0.0f) pickVelocity(i);
+    }
+}
+
+// strafe left or right at a random speed, with a little vertical drift
+void Simulation::pickVelocity(const int &id)
+{
+    float speed = minSpeed + (maxSpeed - minSpeed) * random.nextFloat();
+    float horizontal = random.below(2) ? speed : -speed;
+    float vertical = (random.nextFloat() * 2.0f - 1.0f) * speed * VERTICAL_RATIO;
+    targets.setVelocity(id, glm::vec3(horizontal, vertical, 0.0f));
+    strafeTimer[id] = STRAFE_MIN + (STRAFE_MAX - STRAFE_MIN) * random.nextFloat();
+}
+
+void Simulation::respawn(const int &id, const glm::vec3 &center)
+{
+    targets.setCenter(id, center);
+    previous[id] = center;
+    pickVelocity(id);
+}
+
+glm::vec3 Simulation::getCenter(const int &id) const
+{
+    return targets.getCenter(id);
+}
+
+glm::vec3 Simulation::getDisplayPosition(const int &id, const Timestamp &renderTime) const
+{
+    float alpha = std::clamp((renderTime - time) / (float)STEP, 0.0f, 1.0f);
+    return glm::mix(previous[id], targets.getCenter(id), alpha);
+}
+
+int Simulation::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    return targets.raycast(origin, direction, distance);
+}
\ No newline at end of file
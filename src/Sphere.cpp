@@ -2,9 +2,12 @@
 #include <GLFW/glfw3.h>
 
 #include "../inc/Sphere.h"
+#include "../inc/RenderStats.h"
 
-Sphere::Sphere(const glm::vec3 &center, const float &radius, const glm::vec3 &color, const Shader &shader, const Camera &camera, const DirectLight &directLight, const int &smoothness/* = 16)*/)
-    : camera(camera), directLight(directLight), shader(shader)
+std::map<int, Sphere::Mesh> Sphere::meshes;
+
+Sphere::Sphere(const glm::vec3 &center, const float &radius, const glm::vec3 &color, const Shader &shader, const int &smoothness/* = 16)*/)
+    : shader(shader)
 {
     this->center = center;
     this->radius = radius;
@@ -12,24 +15,69 @@ Sphere::Sphere(const glm::vec3 &center, const float &radius, const glm::vec3 &co
     this->smoothness = smoothness;
     shineness = 8;
     posInGrid = -1; // not in grid
+    spawnTime = 0;
+    mesh = nullptr;
+    changed = true;
+    updateModel();
 }
 
 Sphere::~Sphere()
 {
-    // remember to release the memory
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VAO);
+    if (mesh != nullptr) releaseMesh(smoothness);
 }
 
-void Sphere::init()
+Sphere::Mesh *Sphere::acquireMesh(const int &smoothness)
 {
-    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    auto it = meshes.find(smoothness);
+    if (it == meshes.end())
     {
-        std::cout << "The OpenGL context was not created";
-        throw "The OpenGL context was not created";
+        // first user of this smoothness: build the mesh and upload it once
+        std::vector<float> vertices; // vertex.x, y, z, normal.x, y, z
+        buildUnitSphere(vertices, smoothness);
+
+        Mesh newMesh;
+        newMesh.vertexCount = vertices.size() / 6;
+        newMesh.users = 0;
+        glGenBuffers(1, &newMesh.VBO);
+        glGenVertexArrays(1, &newMesh.VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, newMesh.VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+        // position attribute
+        glBindVertexArray(newMesh.VAO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        it = meshes.emplace(smoothness, newMesh).first;
     }
+    it->second.users++;
+    return &it->second;
+}
+
+void Sphere::releaseMesh(const int &smoothness)
+{
+    auto it = meshes.find(smoothness);
+    if (it == meshes.end()) return;
+    // remember to release the memory once the last user of the mesh is gone
+    if (--it->second.users == 0)
+    {
+        glDeleteBuffers(1, &it->second.VBO);
+        glDeleteVertexArrays(1, &it->second.VAO);
+        meshes.erase(it);
+    }
+}
 
-    vertices.reserve(smoothness * smoothness * 2 * 3);
+// unit sphere (center at origin, radius 1), the actual position and size come from the model matrix
+void Sphere::buildUnitSphere(std::vector<float> &vertices, const int &smoothness)
+{
+    const glm::vec3 center(0.0f);
+    const float radius = 1.0f;
+    vertices.reserve(smoothness * smoothness * 2 * 3 * 6);
     int sidesAmount = smoothness;
     for (int i = 0; i < sidesAmount; i++)
     {
@@ -94,39 +142,44 @@ void Sphere::init()
             vertices.insert(vertices.end(), { normal.x, normal.y, normal.z });
         }
     }
-    shader.use();
-    glGenBuffers(1, &VBO);
-    glGenVertexArrays(1, &VAO);
+}
+
+void Sphere::init()
+{
+    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+    if (mesh != nullptr) return; // already initialized
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+    mesh = acquireMesh(smoothness);
+    initUniforms();
+}
 
-    // position attribute
-    glBindVertexArray(VAO);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+void Sphere::updateModel()
+{
+    model = glm::translate(glm::mat4(1.0f), center);
+    model = glm::scale(model, glm::vec3(radius));
+}
+
+void Sphere::initUniforms()
+{
+    uniforms.model = shader.uniform("model");
+    uniforms.shininess = shader.uniform("material.shininess");
+    uniforms.color = shader.uniform("aColor");
 }
 
 void Sphere::setMatrix()
 {
     shader.use();
-    // camera
-    shader.setMat4("view", camera.getViewMatrix());
-    shader.setMat4("projection", camera.getPersMatrix());
-    shader.setVec3("cameraPos", camera.getPosition());
-
-    // direct light
-    shader.setVec3("directLight.direction", directLight.direction);
-    shader.setVec3("directLight.ambient", directLight.ambient);
-    shader.setVec3("directLight.diffuse", directLight.diffuse);
-    shader.setVec3("directLight.specular", directLight.specular);
+    // model
+    shader.setMat4(uniforms.model, model);
 
     // material
-    shader.setFloat("material.shininess", shineness);
+    shader.setFloat(uniforms.shininess, shineness);
 
-    shader.setVec3("aColor", color);
+    shader.setVec3(uniforms.color, color);
 
     // ---------------
     glUseProgram(NULL);
@@ -135,23 +188,18 @@ void Sphere::setMatrix()
 
 void Sphere::renderSphere()
 {
-    if (vertices.empty())
+    if (mesh == nullptr)
     {
-        std::cout << "Vertice is empty, maybe the init was fail" << std::endl;
-        return;
-    }
-    if (vertices.size() % 3 != 0)
-    {
-        std::cout << "The size of vertice is not a multiple of 3" << std::endl;
+        std::cout << "Sphere mesh is empty, maybe the init was fail" << std::endl;
         return;
     }
 
     setMatrix();
     shader.use();
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, vertices.size() / 6);
+    glBindVertexArray(mesh->VAO);
+    glDrawArrays(GL_TRIANGLES, 0, mesh->vertexCount);
+    RenderStats::addDraw(mesh->vertexCount / 3);
+    glBindVertexArray(0);
     glUseProgram(NULL);
 }
 
@@ -187,16 +235,9 @@ void Sphere::renderSphere()
 
 void Sphere::move(const glm::vec3 &newCenter)
 {
-    float xOffset = newCenter.x - center.x;
-    float yOffset = newCenter.y - center.y;
-    float zOffset = newCenter.z - center.z;
-    for (int i = 0; i < vertices.size(); i += 6)
-    {
-        vertices[i] += xOffset;
-        vertices[i + 1] += yOffset;
-        vertices[i + 2] += zOffset;
-    }
     center = newCenter;
+    changed = true;
+    updateModel();
 }
 
 glm::vec3 Sphere::getCenter()
@@ -209,34 +250,44 @@ float Sphere::getRadius()
     return radius;
 }
 
-void Sphere::setGridPos()
+glm::vec3 Sphere::getColor()
 {
-    static bool posOccupation[25] = { false };
-    int i = 0;
-    for (i = 0; i < 25; i++)
-    {
-        if (posOccupation[i] == false) break;
-    }
-    if (i == 25)
-    {
-        std::cout << "Sphere::Pos is full";
-        throw "Sphere::Pos is full";
-    }
-    srand(time(0));
-    int nextGridPos = rand() % 25;
-    while (posOccupation[nextGridPos] == true)
-    {
-        nextGridPos = rand() % 25;
-    }
+    return color;
+}
+
+bool Sphere::hasChanged() const
+{
+    return changed;
+}
+
+void Sphere::clearChanged()
+{
+    changed = false;
+}
 
-    if (posInGrid >= 0)
+Timestamp Sphere::getSpawnTime()
+{
+    return spawnTime;
+}
+
+int Sphere::getGridPos()
+{
+    return posInGrid;
+}
+
+bool Sphere::setGridPos(TargetPlacer &placer, const Timestamp &spawnTime/* = nowMicros()*/)
+{
+    // taken before the old cell is released, so the target always jumps somewhere else
+    int nextGridPos = placer.acquire();
+    if (nextGridPos < 0)
     {
-        posOccupation[posInGrid] = false;
+        std::cout << "Sphere::Pos is full" << std::endl;
+        return false;
     }
-    posOccupation[nextGridPos] = true;
+    placer.release(posInGrid);
     posInGrid = nextGridPos;
+    this->spawnTime = spawnTime;
 
-    move(glm::vec3(10.0f + 1.5f + (posInGrid % 5) * 3.0f,
-        1.5f + (posInGrid / 5) * 3.0f,
-        1.0f));
+    move(placer.cellCenter(posInGrid));
+    return true;
 }
\ No newline at end of file
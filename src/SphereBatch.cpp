@@ -0,0 +1,154 @@
+#include "../inc/SphereBatch.h"
+#include "../inc/RenderStats.h"
+
+SphereBatch::SphereBatch(const Shader &shader, const int &smoothness/* = 16*/)
+    : shader(shader)
+{
+    this->smoothness = smoothness;
+    shineness = 8;
+    objectIdBase = 1;
+    capacity = 0;
+    mesh = nullptr;
+    instanceVBO = 0;
+    VAO = 0;
+}
+
+SphereBatch::~SphereBatch()
+{
+    // remember to release the memory
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteVertexArrays(1, &VAO);
+    if (mesh != nullptr) Sphere::releaseMesh(smoothness);
+}
+
+void SphereBatch::init()
+{
+    if (glGetError() == GL_INVALID_OPERATION) // check OpenGL context
+    {
+        std::cout << "The OpenGL context was not created";
+        throw "The OpenGL context was not created";
+    }
+
+    mesh = Sphere::acquireMesh(smoothness);
+    initUniforms();
+
+    glGenBuffers(1, &instanceVBO);
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    // per-vertex attributes come from the shared unit sphere
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->VBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void *)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // per-instance attributes: center, radius, color
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)offsetof(Instance, center));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)offsetof(Instance, radius));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void *)offsetof(Instance, color));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+int SphereBatch::add(Sphere &sphere)
+{
+    spheres.push_back(&sphere);
+    instances.push_back({ sphere.getCenter(), sphere.getRadius(), sphere.getColor() });
+    sphere.clearChanged();
+    return spheres.size() - 1;
+}
+
+int SphereBatch::size() const
+{
+    return spheres.size();
+}
+
+void SphereBatch::setObjectIdBase(const int &objectIdBase)
+{
+    this->objectIdBase = objectIdBase;
+}
+
+void SphereBatch::initUniforms()
+{
+    uniforms.shininess = shader.uniform("material.shininess");
+    uniforms.objectIdBase = shader.uniform("objectIdBase");
+}
+
+void SphereBatch::setMatrix()
+{
+    shader.use();
+    // material
+    shader.setFloat(uniforms.shininess, shineness);
+    shader.setInt(uniforms.objectIdBase, objectIdBase);
+
+    // ---------------
+    glUseProgram(NULL);
+}
+
+// upload only the instances of the spheres moved since the last frame,
+// neighbouring changed instances are merged into one glBufferSubData
+void SphereBatch::updateInstances()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (capacity < (int)instances.size())
+    {
+        // grow the buffer and upload everything
+        for (int i = 0; i < (int)spheres.size(); i++)
+        {
+            instances[i] = { spheres[i]->getCenter(), spheres[i]->getRadius(), spheres[i]->getColor() };
+            spheres[i]->clearChanged();
+        }
+        capacity = instances.capacity();
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Instance), NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(Instance), instances.data());
+    }
+    else
+    {
+        int first = -1;
+        for (int i = 0; i <= (int)spheres.size(); i++)
+        {
+            if (i < (int)spheres.size() && spheres[i]->hasChanged())
+            {
+                instances[i].center = spheres[i]->getCenter();
+                instances[i].radius = spheres[i]->getRadius();
+                instances[i].color = spheres[i]->getColor();
+                spheres[i]->clearChanged();
+                if (first < 0) first = i;
+            }
+            else if (first >= 0)
+            {
+                glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Instance), (i - first) * sizeof(Instance), &instances[first]);
+                first = -1;
+            }
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SphereBatch::renderSpheres()
+{
+    if (mesh == nullptr)
+    {
+        std::cout << "Sphere mesh is empty, maybe the init was fail" << std::endl;
+        return;
+    }
+    if (spheres.empty()) return;
+
+    updateInstances();
+    setMatrix();
+    shader.use();
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, mesh->vertexCount, spheres.size());
+    RenderStats::addDraw(mesh->vertexCount / 3 * spheres.size());
+    glBindVertexArray(0);
+    glUseProgram(NULL);
+}
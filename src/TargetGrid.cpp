@@ -0,0 +1,203 @@
+#include "../inc/TargetGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TargetGrid::TargetGrid(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const float &cellSize)
+{
+    this->boundsMin = boundsMin;
+    this->boundsMax = boundsMax;
+    this->cellSize = cellSize;
+    cellCount = glm::max(glm::ivec3(glm::ceil((boundsMax - boundsMin) / cellSize)), glm::ivec3(1));
+    cells.resize(cellCount.x * cellCount.y * cellCount.z);
+    rayStamp = 0;
+}
+
+int TargetGrid::cellIndex(const glm::ivec3 &cell) const
+{
+    return (cell.z * cellCount.y + cell.y) * cellCount.x + cell.x;
+}
+
+int TargetGrid::add(Sphere &sphere)
+{
+    Target target;
+    target.sphere = &sphere;
+    targets.push_back(target);
+    testedRay.push_back(0);
+    insert(targets.size() - 1);
+    return targets.size() - 1;
+}
+
+void TargetGrid::update(const int &id)
+{
+    erase(id);
+    insert(id);
+}
+
+void TargetGrid::insert(const int &id)
+{
+    Target &target = targets[id];
+    glm::vec3 center = target.sphere->getCenter();
+    float radius = target.sphere->getRadius();
+    glm::vec3 lower = center - radius;
+    glm::vec3 upper = center + radius;
+    Entry entry{ center, radius, id };
+
+    target.outside = glm::any(glm::lessThan(lower, boundsMin)) || glm::any(glm::greaterThan(upper, boundsMax));
+    if (target.outside)
+    {
+        outsideTargets.push_back(entry);
+        return;
+    }
+
+    target.cellMin = glm::min(glm::ivec3(glm::floor((lower - boundsMin) / cellSize)), cellCount - 1);
+    target.cellMax = glm::min(glm::ivec3(glm::floor((upper - boundsMin) / cellSize)), cellCount - 1);
+    for (int z = target.cellMin.z; z <= target.cellMax.z; z++)
+        for (int y = target.cellMin.y; y <= target.cellMax.y; y++)
+            for (int x = target.cellMin.x; x <= target.cellMax.x; x++)
+                cells[cellIndex(glm::ivec3(x, y, z))].push_back(entry);
+}
+
+void TargetGrid::erase(const int &id)
+{
+    // order inside a cell does not matter, swap with the last one
+    auto eraseFrom = [id](std::vector<Entry> &list) {
+        auto it = std::find_if(list.begin(), list.end(), [id](const Entry &entry) { return entry.id == id; });
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    };
+
+    Target &target = targets[id];
+    if (target.outside)
+    {
+        eraseFrom(outsideTargets);
+        return;
+    }
+    for (int z = target.cellMin.z; z <= target.cellMax.z; z++)
+        for (int y = target.cellMin.y; y <= target.cellMax.y; y++)
+            for (int x = target.cellMin.x; x <= target.cellMax.x; x++)
+                eraseFrom(cells[cellIndex(glm::ivec3(x, y, z))]);
+}
+
+int TargetGrid::size() const
+{
+    return targets.size();
+}
+
+Sphere &TargetGrid::getSphere(const int &id)
+{
+    return *targets[id].sphere;
+}
+
+bool TargetGrid::intersectSphere(const glm::vec3 &origin, const glm::vec3 &direction, const glm::vec3 &center, const float &radius, float &distance)
+{
+    glm::vec3 oc = center - origin;
+    float projection = glm::dot(oc, direction);
+    float centerDistance2 = glm::dot(oc, oc);
+    float radius2 = radius * radius;
+    if (centerDistance2 <= radius2)
+    {
+        distance = 0.0f;
+        return true;
+    }
+    if (projection <= 0.0f) return false; // behind the origin
+    float h2 = radius2 - (centerDistance2 - projection * projection);
+    if (h2 < 0.0f) return false;
+    distance = projection - std::sqrt(h2);
+    return true;
+}
+
+bool TargetGrid::testTarget(const Entry &entry, const glm::vec3 &origin, const glm::vec3 &direction, float &nearest, int &nearestId) const
+{
+    if (testedRay[entry.id] == rayStamp) return false;
+    testedRay[entry.id] = rayStamp;
+
+    float distance;
+    if (!intersectSphere(origin, direction, entry.center, entry.radius, distance) || distance >= nearest) return false;
+    nearest = distance;
+    nearestId = entry.id;
+    return true;
+}
+
+int TargetGrid::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    const float INF = std::numeric_limits<float>::infinity();
+    glm::vec3 dir = glm::normalize(direction);
+    if (++rayStamp == 0) // wrapped, forget the old stamps
+    {
+        std::fill(testedRay.begin(), testedRay.end(), 0);
+        rayStamp = 1;
+    }
+
+    float nearest = INF;
+    int nearestId = -1;
+    for (const auto &entry : outsideTargets)
+    {
+        testTarget(entry, origin, dir, nearest, nearestId);
+    }
+
+    // where the ray enters and leaves the grid bounds. a ray parallel to a
+    // slab never crosses it: inside it the slab does not limit the ray, outside
+    // it misses the grid. 0 * INF on the slab plane would be NaN
+    glm::vec3 invDir(dir.x != 0.0f ? 1.0f / dir.x : INF, dir.y != 0.0f ? 1.0f / dir.y : INF, dir.z != 0.0f ? 1.0f / dir.z : INF);
+    glm::vec3 tNear, tFar;
+    bool missesGrid = false;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (dir[axis] == 0.0f)
+        {
+            missesGrid = missesGrid || origin[axis] < boundsMin[axis] || origin[axis] > boundsMax[axis];
+            tNear[axis] = -INF;
+            tFar[axis] = INF;
+            continue;
+        }
+        float t0 = (boundsMin[axis] - origin[axis]) * invDir[axis];
+        float t1 = (boundsMax[axis] - origin[axis]) * invDir[axis];
+        tNear[axis] = std::min(t0, t1);
+        tFar[axis] = std::max(t0, t1);
+    }
+    float tEnter = std::max({ tNear.x, tNear.y, tNear.z, 0.0f });
+    float tExit = std::min({ tFar.x, tFar.y, tFar.z });
+
+    if (!missesGrid && tEnter <= tExit && tEnter < nearest)
+    {
+        // 3D DDA, one cell at a time along the ray
+        glm::vec3 entry = origin + dir * tEnter;
+        glm::ivec3 cell = glm::clamp(glm::ivec3(glm::floor((entry - boundsMin) / cellSize)), glm::ivec3(0), cellCount - 1);
+        glm::ivec3 step(dir.x > 0 ? 1 : -1, dir.y > 0 ? 1 : -1, dir.z > 0 ? 1 : -1);
+        glm::vec3 tMax, tDelta;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (dir[axis] == 0.0f)
+            {
+                tMax[axis] = INF;
+                tDelta[axis] = INF;
+                continue;
+            }
+            float boundary = boundsMin[axis] + (cell[axis] + (step[axis] > 0 ? 1 : 0)) * cellSize;
+            tMax[axis] = (boundary - origin[axis]) * invDir[axis];
+            tDelta[axis] = cellSize * std::abs(invDir[axis]);
+        }
+
+        while (true)
+        {
+            for (const auto &entry : cells[cellIndex(cell)])
+            {
+                testTarget(entry, origin, dir, nearest, nearestId);
+            }
+            // a hit before the ray leaves this cell cannot be beaten by later cells
+            float cellExit = std::min({ tMax.x, tMax.y, tMax.z });
+            if (nearest <= cellExit || cellExit > tExit) break;
+
+            int axis = tMax.x < tMax.y ? (tMax.x < tMax.z ? 0 : 2) : (tMax.y < tMax.z ? 1 : 2);
+            cell[axis] += step[axis];
+            if (cell[axis] < 0 || cell[axis] >= cellCount[axis]) break;
+            tMax[axis] += tDelta[axis];
+        }
+    }
+
+    if (nearestId >= 0) distance = nearest;
+    return nearestId;
+}
\ No newline at end of file
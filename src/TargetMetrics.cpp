@@ -0,0 +1,94 @@
+#include "../inc/TargetMetrics.h"
+
+#include <cmath>
+
+RunningStats::RunningStats()
+{
+    count = 0;
+    mean = 0;
+    m2 = 0;
+}
+
+void RunningStats::add(const double &value)
+{
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+
+std::int64_t RunningStats::getCount() const
+{
+    return count;
+}
+
+double RunningStats::getMean() const
+{
+    return mean;
+}
+
+double RunningStats::variance() const
+{
+    return count > 1 ? m2 / (count - 1) : 0.0;
+}
+
+double RunningStats::stdDev() const
+{
+    return std::sqrt(variance());
+}
+
+TargetMetrics::TargetMetrics()
+{
+    aimedTarget = -1;
+    summary = {};
+}
+
+void TargetMetrics::spawn(const int &target, const Timestamp &time, const glm::vec3 &front)
+{
+    if (target >= (int)targets.size()) targets.resize(target + 1);
+    targets[target] = { time, front, 0, 0, 0 };
+    // it moved away from under the crosshair
+    if (aimedTarget == target) aimedTarget = -1;
+}
+
+void TargetMetrics::aim(const int &target, const Timestamp &time)
+{
+    if (target == aimedTarget) return;
+    if (aimedTarget >= 0)
+    {
+        // left before it was hit
+        TargetState &state = targets[aimedTarget];
+        state.timeOnTarget += time - state.onTargetSince;
+        state.overshoots++;
+    }
+    if (target >= 0 && target < (int)targets.size()) targets[target].onTargetSince = time;
+    aimedTarget = target < (int)targets.size() ? target : -1;
+}
+
+void TargetMetrics::hit(const int &target, const Timestamp &time, const glm::vec3 &front)
+{
+    if (target < 0 || target >= (int)targets.size()) return;
+    TargetState &state = targets[target];
+    if (aimedTarget == target) state.timeOnTarget += time - state.onTargetSince;
+
+    Timestamp reactionTime = time - state.spawnTime;
+    reactionTimes.record(reactionTime);
+    reaction.add(reactionTime / 1000.0);
+    flick.add(glm::degrees(std::acos(glm::clamp(glm::dot(state.spawnFront, front), -1.0f, 1.0f))));
+    overshoot.add(state.overshoots);
+    timeOnTarget.add(state.timeOnTarget / 1000.0);
+
+    summary.hits = reaction.getCount();
+    summary.reactionMeanMs = reaction.getMean();
+    summary.reactionStdDevMs = reaction.stdDev();
+    summary.reactionP50Ms = reactionTimes.valueAtPercentile(0.5) / 1000.0;
+    summary.reactionP90Ms = reactionTimes.valueAtPercentile(0.9) / 1000.0;
+    summary.flickMeanDeg = flick.getMean();
+    summary.overshootMean = overshoot.getMean();
+    summary.timeOnTargetMeanMs = timeOnTarget.getMean();
+}
+
+const TargetMetrics::Summary &TargetMetrics::getSummary() const
+{
+    return summary;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "../inc/TargetPlacer.h"
+
+TargetPlacer::TargetPlacer(const glm::ivec3 &cellCount, const glm::vec3 &origin, const glm::vec3 &spacing, const std::uint64_t &seed/* = 0*/)
+    : random(seed)
+{
+    this->cellCount = cellCount;
+    this->origin = origin;
+    this->spacing = spacing;
+
+    int total = cellTotal();
+    occupied.assign((total + 63) / 64, 0);
+    freeCells.resize(total);
+    freeSlot.resize(total);
+    for (int i = 0; i < total; i++)
+    {
+        freeCells[i] = i;
+        freeSlot[i] = i;
+    }
+}
+
+void TargetPlacer::seed(const std::uint64_t &seed)
+{
+    random.seed(seed);
+}
+
+int TargetPlacer::acquire()
+{
+    if (freeCells.empty()) return -1;
+
+    int slot = random.below(freeCells.size());
+    int cell = freeCells[slot];
+    // the last free cell takes its slot
+    freeCells[slot] = freeCells.back();
+    freeSlot[freeCells[slot]] = slot;
+    freeCells.pop_back();
+    freeSlot[cell] = -1;
+    occupied[cell / 64] |= std::uint64_t(1) << (cell % 64);
+    return cell;
+}
+
+void TargetPlacer::release(const int &cell)
+{
+    if (cell < 0 || !isOccupied(cell)) return;
+    occupied[cell / 64] &= ~(std::uint64_t(1) << (cell % 64));
+    freeSlot[cell] = freeCells.size();
+    freeCells.push_back(cell);
+}
+
+bool TargetPlacer::isOccupied(const int &cell) const
+{
+    return (occupied[cell / 64] >> (cell % 64)) & 1;
+}
+
+int TargetPlacer::freeCount() const
+{
+    return freeCells.size();
+}
+
+int TargetPlacer::cellTotal() const
+{
+    return cellCount.x * cellCount.y * cellCount.z;
+}
+
+glm::vec3 TargetPlacer::cellCenter(const int &cell) const
+{
+    int column = cell % cellCount.x;
+    int row = cell / cellCount.x % cellCount.y;
+    int layer = cell / (cellCount.x * cellCount.y);
+    return origin + glm::vec3(column * spacing.x, row * spacing.y, layer * spacing.z);
+}
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "../inc/TargetStore.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TARGET_STORE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// gcc and clang only emit AVX for functions that ask for it, msvc always can
+#if defined(TARGET_STORE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX __attribute__((target("avx")))
+#else
+#define TARGET_AVX
+#endif
+
+namespace {
+    const float INF = std::numeric_limits<float>::infinity();
+}
+
+TargetStore::TargetStore()
+{
+    count = 0;
+    simdLevel = detectSimdLevel();
+}
+
+int TargetStore::add(const glm::vec3 &center, const float &radius, const glm::vec3 &velocity/* = glm::vec3(0.0f)*/)
+{
+    if (count == (int)x.size())
+    {
+        // grow by one block of dead targets
+        size_t padded = x.size() + LANES;
+        for (auto array : { &x, &y, &z, &this->radius, &vx, &vy, &vz })
+        {
+            array->resize(padded, 0.0f);
+        }
+        alive.resize(padded, 0);
+    }
+    int id = count++;
+    setCenter(id, center);
+    setVelocity(id, velocity);
+    this->radius[id] = radius;
+    alive[id] = -1;
+    return id;
+}
+
+int TargetStore::size() const
+{
+    return count;
+}
+
+glm::vec3 TargetStore::getCenter(const int &id) const
+{
+    return glm::vec3(x[id], y[id], z[id]);
+}
+
+float TargetStore::getRadius(const int &id) const
+{
+    return radius[id];
+}
+
+glm::vec3 TargetStore::getVelocity(const int &id) const
+{
+    return glm::vec3(vx[id], vy[id], vz[id]);
+}
+
+bool TargetStore::isAlive(const int &id) const
+{
+    return alive[id] != 0;
+}
+
+void TargetStore::setCenter(const int &id, const glm::vec3 &center)
+{
+    x[id] = center.x;
+    y[id] = center.y;
+    z[id] = center.z;
+}
+
+void TargetStore::setVelocity(const int &id, const glm::vec3 &velocity)
+{
+    vx[id] = velocity.x;
+    vy[id] = velocity.y;
+    vz[id] = velocity.z;
+}
+
+void TargetStore::setAlive(const int &id, const bool &alive)
+{
+    this->alive[id] = alive ? -1 : 0;
+}
+
+TargetStore::SimdLevel TargetStore::detectSimdLevel()
+{
+#if defined(TARGET_STORE_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6; // OSXSAVE, XMM and YMM state
+    if ((info[2] & (1 << 28)) && osSavesYmm) return SimdLevel::AVX;
+    if (info[3] & (1 << 26)) return SimdLevel::SSE;
+    return SimdLevel::SCALAR;
+#elif defined(TARGET_STORE_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) return SimdLevel::AVX;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE;
+    return SimdLevel::SCALAR;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+// levels the cpu does not support fall back to the best one it does
+void TargetStore::setSimdLevel(const SimdLevel &level)
+{
+    simdLevel = std::min(level, detectSimdLevel());
+}
+
+TargetStore::SimdLevel TargetStore::getSimdLevel() const
+{
+    return simdLevel;
+}
+
+int TargetStore::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    glm::vec3 dir = glm::normalize(direction);
+    switch (simdLevel)
+    {
+    case SimdLevel::AVX: return raycastAVX(origin, dir, distance);
+    case SimdLevel::SSE: return raycastSSE(origin, dir, distance);
+    default: return raycastScalar(origin, dir, distance);
+    }
+}
+
+void TargetStore::integrate(const float &deltaTime)
+{
+    switch (simdLevel)
+    {
+    case SimdLevel::AVX: integrateAVX(deltaTime); break;
+    case SimdLevel::SSE: integrateSSE(deltaTime); break;
+    default: integrateScalar(deltaTime); break;
+    }
+}
+
+// same math in every version: inside the sphere is a hit at 0, otherwise the
+// near intersection if the center is in front and the ray is within the radius
+int TargetStore::raycastScalar(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    float nearest = INF;
+    int nearestId = -1;
+    for (int i = 0; i < count; i++)
+    {
+        if (!alive[i]) continue;
+        float cx = x[i] - origin.x, cy = y[i] - origin.y, cz = z[i] - origin.z;
+        float projection = cx * direction.x + cy * direction.y + cz * direction.z;
+        float centerDistance2 = cx * cx + cy * cy + cz * cz;
+        float radius2 = radius[i] * radius[i];
+        float h2 = radius2 - (centerDistance2 - projection * projection);
+        float t;
+        if (centerDistance2 <= radius2) t = 0.0f;
+        else if (projection > 0.0f && h2 >= 0.0f) t = projection - std::sqrt(h2);
+        else continue;
+        if (t < nearest)
+        {
+            nearest = t;
+            nearestId = i;
+        }
+    }
+    if (nearestId >= 0) distance = nearest;
+    return nearestId;
+}
+
+void TargetStore::integrateScalar(const float &deltaTime)
+{
+    for (int i = 0; i < count; i++)
+    {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        z[i] += vz[i] * deltaTime;
+    }
+}
+
+#ifdef TARGET_STORE_X86
+
+int TargetStore::raycastSSE(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+    const __m128 dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+    const __m128 zero = _mm_setzero_ps(), inf = _mm_set1_ps(INF), step = _mm_set1_ps(4.0f);
+    __m128 bestT = inf;
+    __m128 bestIndex = _mm_set1_ps(-1.0f);
+    __m128 index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 cx = _mm_sub_ps(_mm_loadu_ps(&x[i]), ox);
+        __m128 cy = _mm_sub_ps(_mm_loadu_ps(&y[i]), oy);
+        __m128 cz = _mm_sub_ps(_mm_loadu_ps(&z[i]), oz);
+        __m128 projection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, dx), _mm_mul_ps(cy, dy)), _mm_mul_ps(cz, dz));
+        __m128 centerDistance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+        __m128 r = _mm_loadu_ps(&radius[i]);
+        __m128 radius2 = _mm_mul_ps(r, r);
+        __m128 h2 = _mm_sub_ps(radius2, _mm_sub_ps(centerDistance2, _mm_mul_ps(projection, projection)));
+
+        __m128 inside = _mm_cmple_ps(centerDistance2, radius2);
+        __m128 front = _mm_and_ps(_mm_cmpgt_ps(projection, zero), _mm_cmpge_ps(h2, zero));
+        __m128 hit = _mm_and_ps(_mm_or_ps(inside, front), _mm_castsi128_ps(_mm_loadu_si128((const __m128i *)&alive[i])));
+        __m128 t = _mm_sub_ps(projection, _mm_sqrt_ps(_mm_max_ps(h2, zero)));
+        t = _mm_andnot_ps(inside, t); // 0 inside
+        t = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, inf));
+
+        __m128 closer = _mm_cmplt_ps(t, bestT);
+        bestT = _mm_or_ps(_mm_and_ps(closer, t), _mm_andnot_ps(closer, bestT));
+        bestIndex = _mm_or_ps(_mm_and_ps(closer, index), _mm_andnot_ps(closer, bestIndex));
+        index = _mm_add_ps(index, step);
+    }
+
+    alignas(16) float lanesT[4], lanesIndex[4];
+    _mm_store_ps(lanesT, bestT);
+    _mm_store_ps(lanesIndex, bestIndex);
+    int lane = std::min_element(lanesT, lanesT + 4) - lanesT;
+    if (lanesT[lane] == INF) return -1;
+    distance = lanesT[lane];
+    return (int)lanesIndex[lane];
+}
+
+void TargetStore::integrateSSE(const float &deltaTime)
+{
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (int i = 0; i < count; i += 4)
+    {
+        _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(_mm_loadu_ps(&vx[i]), dt)));
+        _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(_mm_loadu_ps(&vy[i]), dt)));
+        _mm_storeu_ps(&z[i], _mm_add_ps(_mm_loadu_ps(&z[i]), _mm_mul_ps(_mm_loadu_ps(&vz[i]), dt)));
+    }
+}
+
+TARGET_AVX int TargetStore::raycastAVX(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y), oz = _mm256_set1_ps(origin.z);
+    const __m256 dx = _mm256_set1_ps(direction.x), dy = _mm256_set1_ps(direction.y), dz = _mm256_set1_ps(direction.z);
+    const __m256 zero = _mm256_setzero_ps(), inf = _mm256_set1_ps(INF), step = _mm256_set1_ps(8.0f);
+    __m256 bestT = inf;
+    __m256 bestIndex = _mm256_set1_ps(-1.0f);
+    __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+    for (int i = 0; i < count; i += 8)
+    {
+        __m256 cx = _mm256_sub_ps(_mm256_loadu_ps(&x[i]), ox);
+        __m256 cy = _mm256_sub_ps(_mm256_loadu_ps(&y[i]), oy);
+        __m256 cz = _mm256_sub_ps(_mm256_loadu_ps(&z[i]), oz);
+        __m256 projection = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, dx), _mm256_mul_ps(cy, dy)), _mm256_mul_ps(cz, dz));
+        __m256 centerDistance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, cx), _mm256_mul_ps(cy, cy)), _mm256_mul_ps(cz, cz));
+        __m256 r = _mm256_loadu_ps(&radius[i]);
+        __m256 radius2 = _mm256_mul_ps(r, r);
+        __m256 h2 = _mm256_sub_ps(radius2, _mm256_sub_ps(centerDistance2, _mm256_mul_ps(projection, projection)));
+
+        __m256 inside = _mm256_cmp_ps(centerDistance2, radius2, _CMP_LE_OQ);
+        __m256 front = _mm256_and_ps(_mm256_cmp_ps(projection, zero, _CMP_GT_OQ), _mm256_cmp_ps(h2, zero, _CMP_GE_OQ));
+        __m256 hit = _mm256_and_ps(_mm256_or_ps(inside, front), _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *)&alive[i])));
+        __m256 t = _mm256_sub_ps(projection, _mm256_sqrt_ps(_mm256_max_ps(h2, zero)));
+        // selects with and/or, blendv on an integer mask needs AVX2 and gcc splits it into branches without it
+        t = _mm256_andnot_ps(inside, t); // 0 inside
+        t = _mm256_or_ps(_mm256_and_ps(hit, t), _mm256_andnot_ps(hit, inf));
+
+        __m256 closer = _mm256_cmp_ps(t, bestT, _CMP_LT_OQ);
+        bestT = _mm256_or_ps(_mm256_and_ps(closer, t), _mm256_andnot_ps(closer, bestT));
+        bestIndex = _mm256_or_ps(_mm256_and_ps(closer, index), _mm256_andnot_ps(closer, bestIndex));
+        index = _mm256_add_ps(index, step);
+    }
+
+    alignas(32) float lanesT[8], lanesIndex[8];
+    _mm256_store_ps(lanesT, bestT);
+    _mm256_store_ps(lanesIndex, bestIndex);
+    int lane = std::min_element(lanesT, lanesT + 8) - lanesT;
+    if (lanesT[lane] == INF) return -1;
+    distance = lanesT[lane];
+    return (int)lanesIndex[lane];
+}
+
+TARGET_AVX void TargetStore::integrateAVX(const float &deltaTime)
+{
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    for (int i = 0; i < count; i += 8)
+    {
+        _mm256_storeu_ps(&x[i], _mm256_add_ps(_mm256_loadu_ps(&x[i]), _mm256_mul_ps(_mm256_loadu_ps(&vx[i]), dt)));
+        _mm256_storeu_ps(&y[i], _mm256_add_ps(_mm256_loadu_ps(&y[i]), _mm256_mul_ps(_mm256_loadu_ps(&vy[i]), dt)));
+        _mm256_storeu_ps(&z[i], _mm256_add_ps(_mm256_loadu_ps(&z[i]), _mm256_mul_ps(_mm256_loadu_ps(&vz[i]), dt)));
+    }
+}
+
+#else
+
+// no x86 intrinsics, setSimdLevel() never selects these
+int TargetStore::raycastSSE(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    return raycastScalar(origin, direction, distance);
+}
+
+void TargetStore::integrateSSE(const float &deltaTime)
+{
+    integrateScalar(deltaTime);
+}
+
+int TargetStore::raycastAVX(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const
+{
+    return raycastScalar(origin, direction, distance);
+}
+
+void TargetStore::integrateAVX(const float &deltaTime)
+{
+    integrateScalar(deltaTime);
+}
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <filesystem>
 #include <map>
+#include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -19,16 +20,33 @@
 #include "../inc/Camera.h"
 #include "../inc/DirectLight.h"
 #include "../inc/Sphere.h"
+#include "../inc/SphereBatch.h"
+#include "../inc/FrameData.h"
 #include "../inc/Cube.h"
 #include "../inc/MyPrinter.h"
 #include "../inc/Crosshair.h"
+#include "../inc/InputEvent.h"
+#include "../inc/RawMouse.h"
+#include "../inc/Options.h"
+#include "../inc/RenderStats.h"
+#include "../inc/Profiler.h"
+#include "../inc/FrameStats.h"
+#include "../inc/PickingBuffer.h"
+#include "../inc/Game.h"
+#include "../inc/FramePacer.h"
+#include "../inc/LatencyTester.h"
+#include "../inc/SessionRecorder.h"
+#include "../inc/SessionLog.h"
+#include "../inc/ShaderWatcher.h"
 
 void getMonitorResolution();
 void framebuffer_size_callback(GLFWwindow *window, int width, int height);
 void mouseMoveCallback(GLFWwindow *window, double xposIn, double yposIn);
 void mouseClickCallback(GLFWwindow *window, int button, int action, int mods);
+void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
 void processInput(GLFWwindow *window);
-void updateDeltaTime();
+void processPicks();
+int replaySession(const std::string &path);
 GLuint loadTexture(const std::string &path);
 
 void renderTriangle(const glm::vec3 &vertex_0, const glm::vec3 &vertex_1, const glm::vec3 &vertex_2, const glm::vec3 &color, const Shader &shader);
@@ -58,13 +76,9 @@ const glm::vec3 CAMERA_POS_DEFAULT(20.0f, 1.0f, 18.0f);
 const glm::vec3 CAMERA_FRONT_DEFAULT(0.0f, 0.0f, -1.0f);
 const glm::vec3 CAMERA_UP_DEFAULT(0.0f, 1.0f, 0.0f);
 
-// create camera
+// create camera, the render side copy follows the game snapshots
 Camera camera(CAMERA_POS_DEFAULT, CAMERA_FRONT_DEFAULT);
 
-// track the change of time
-float deltaTime = 0.0f;
-float lastFrameTime = 0.0f;
-
 // background color
 const glm::vec4 BACKGROUND_COLOR(133 / 255.0f, 204 / 255.0f, 255 / 255.0f, 1.0f);
 
@@ -74,16 +88,44 @@ glm::vec3 wallColor(255 / 255.0, 229 / 255.0, 204 / 255.0);
 glm::vec3 sphereColor(0 / 255.0, 255 / 255.0, 255 / 255.0);
 float radius = 1.0f;
 Sphere spheres[] = {
-        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, camera, directLight, 64),
-        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, camera, directLight, 64),
-        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, camera, directLight, 64),
+        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, 64),
+        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, 64),
+        Sphere(glm::vec3(-1.0), radius, sphereColor, triangleShader, 64),
 };
 
-int hitTimes = 0;
-int clickTimes = 0;
+// gpu picking: the target pass writes object ids, sphere i of the batch is Game::TARGET_ID_BASE + i
+PickingBuffer pickingBuffer;
+bool useGpuPicking = false;
+
+// camera, targets and scoring, created once the options are known
+Game *game = nullptr;
+
+// inputs, spawns and hits of the session, written on a background thread
+SessionRecorder recorder;
+
+// raw input thread, used instead of the cursor callbacks when running
+RawMouse rawMouse;
+bool useRawMouse = false;
+
+// presented frame times over a sliding window and the whole session
+FrameStats frameStats;
 
-int main()
+// longest the render thread waits for the game to handle the polled input
+const Timestamp INPUT_LATCH_TIMEOUT = 2 * Simulation::STEP;
+
+// F3 toggles the profiler overlay
+bool showProfiler = false;
+
+int main(int argc, char **argv)
 {
+    Options options = parseOptions(argc, argv);
+    if (!options.replayPath.empty()) return replaySession(options.replayPath);
+
+    std::uint64_t seed = options.hasSeed ? options.seed : Random::randomSeed();
+    std::cout << "Seed: " << seed << std::endl;
+    Game gameState(options, seed, camera, triangleShader);
+    game = &gameState;
+
     // glfw: initialize and configure
     // ------------------------------
     glfwInit();
@@ -107,9 +149,22 @@ int main()
         return -1;
     }
     glfwMakeContextCurrent(window);
+    FramePacer framePacer((FramePacer::Mode)options.presentMode, options.fpsCap, options.jitWaitMs);
+    framePacer.init(glfwGetVideoMode(glfwGetPrimaryMonitor())->refreshRate);
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    glfwSetCursorPosCallback(window, mouseMoveCallback);
-    glfwSetMouseButtonCallback(window, mouseClickCallback);
+    if (options.inputMode == Options::InputMode::RAW_THREAD)
+    {
+        useRawMouse = rawMouse.start();
+        if (!useRawMouse) std::cout << "Raw input thread unavailable, falling back to GLFW input" << std::endl;
+    }
+    if (!useRawMouse)
+    {
+        if (glfwRawMouseMotionSupported()) glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+        glfwSetCursorPosCallback(window, mouseMoveCallback);
+        glfwSetMouseButtonCallback(window, mouseClickCallback);
+    }
+    if (useRawMouse) game->setRawMouse(&rawMouse);
+    glfwSetKeyCallback(window, keyCallback);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
     // glad: load all OpenGL function pointers
@@ -126,7 +181,10 @@ int main()
     glEnable(GL_DEPTH_TEST);
     // build and compile our shader program
     // ------------------------------------
+    if (!options.shaderCachePath.empty()) Shader::enableProgramCache((rootPath / options.shaderCachePath).string(), (GLADloadproc)glfwGetProcAddress);
     triangleShader.init();
+    Shader sphereShader((shaderPath / "sphere_instanced.vert").string(), (shaderPath / "triangle.frag").string());
+    sphereShader.init();
     Shader boxShader((shaderPath / "box.vert").string(), (shaderPath / "box.frag").string());
     boxShader.init();
     Shader lightingCubeShader((shaderPath / "light_cube.vert").string(), (shaderPath / "light_cube.frag").string());
@@ -135,68 +193,159 @@ int main()
     textShader.init();
     Shader crosshairShader((shaderPath / "crosshair.vert").string(), (shaderPath / "crosshair.frag").string());
     crosshairShader.init();
+    Shader graphShader((shaderPath / "crosshair.vert").string(), (shaderPath / "crosshair.frag").string());
+    graphShader.init();
+    Shader markerShader((shaderPath / "crosshair.vert").string(), (shaderPath / "crosshair.frag").string());
+    markerShader.init();
+
+    // edited shaders are linked again between frames, a program that fails to link is not swapped in
+    ShaderWatcher shaderWatcher(shaderPath.string());
+    if (options.watchShaders)
+    {
+        for (Shader *shader : { &triangleShader, &sphereShader, &boxShader, &lightingCubeShader, &textShader, &crosshairShader, &graphShader, &markerShader })
+        {
+            shaderWatcher.add(*shader);
+        }
+        shaderWatcher.start();
+    }
 
-    MyPrinter printer(std::filesystem::path("C:/Windows/Fonts/consola.ttf").string().c_str(), textShader, screenWidth, screenHeight);
+    // camera and light are uploaded once per frame for all programs
+    FrameData frameData(camera, directLight);
+    frameData.init();
 
+    MyPrinter printer(std::filesystem::path("C:/Windows/Fonts/consola.ttf").string().c_str(), textShader, screenWidth, screenHeight);
+    // HUD, laid out again only when the displayed text changes
+    const glm::vec3 hudColor(0.0f, 0.0f, 0.0f);
+    int fpsText = printer.createText(10.0f, screenHeight - 40.0, 0.5f, hudColor);
+    int timeText = printer.createText(10.0f, screenHeight - 60.0, 0.5f, hudColor);
+    int hitTimesText = printer.createText(10.0f, screenHeight - 80.0, 0.5f, hudColor);
+    int accuracyText = printer.createText(10.0f, screenHeight - 100.0, 0.5f, hudColor);
+    int KPMText = printer.createText(10.0f, screenHeight - 120.0, 0.5f, hudColor);
+    int reactionText = printer.createText(10.0f, screenHeight - 140.0, 0.5f, hudColor);
+    int frameTimeText = printer.createText(10.0f, screenHeight - 160.0, 0.5f, hudColor);
+    int flickText = printer.createText(10.0f, screenHeight - 180.0, 0.5f, hudColor);
+    int latencyText = printer.createText(10.0f, screenHeight - 200.0, 0.5f, hudColor);
+    int quitText = printer.createText(10.0f, 25, 0.5f, hudColor);
+    printer.setText(quitText, std::string_view("PRESS ESC TO QUIT"));
+
+    // every target is drawn by one instanced call
+    SphereBatch sphereBatch(sphereShader, 64);
+    sphereBatch.init();
+    sphereBatch.setObjectIdBase(Game::TARGET_ID_BASE);
+    if (!options.recordPath.empty() && recorder.open(options.recordPath, game->sessionHeader(seed, radius)))
+    {
+        game->setRecorder(&recorder);
+    }
     for (auto &sphere : spheres)
     {
-        sphere.init();
-        sphere.setGridPos();
+        if (game->addTarget(sphere.getRadius()) < 0) break;
+        sphereBatch.add(sphere);
     }
 
     Cube cubes[] = {
-    Cube(glm::vec3(0.0f), 40.0f, 0.01f, 20.0f, wallColor * 1.2f, triangleShader, camera, directLight), // floor
-    Cube(glm::vec3(0.0f), 40.0f, 18.0f, 0.01f, wallColor, triangleShader, camera, directLight), // back wall
-    Cube(glm::vec3(0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader, camera, directLight), // left wall
-    Cube(glm::vec3(40.0f, 0.0f, 0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader, camera, directLight), // right wall
+    Cube(glm::vec3(0.0f), 40.0f, 0.01f, 20.0f, wallColor * 1.2f, triangleShader), // floor
+    Cube(glm::vec3(0.0f), 40.0f, 18.0f, 0.01f, wallColor, triangleShader), // back wall
+    Cube(glm::vec3(0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader), // left wall
+    Cube(glm::vec3(40.0f, 0.0f, 0.0f), 0.01f, 18.0f, 20.0f, wallColor, triangleShader), // right wall
     };
 
     Crosshair crosshair(crosshairShader, 10.0, glm::vec3(1.0f, 0.0f, 0.0f), screenWidth, screenHeight);
     crosshair.init();
 
+    Profiler profiler(graphShader, printer, screenWidth, screenHeight);
+    profiler.init();
+    int sphereSection = profiler.addSection("spheres");
+    int cubeSection = profiler.addSection("cubes");
+    int crosshairSection = profiler.addSection("crosshair");
+    int textSection = profiler.addSection("text");
+    if (!options.profileOutPath.empty()) profiler.startRecording();
+
+    useGpuPicking = options.hitMode == Options::HitMode::GPU_PICKING;
+    if (useGpuPicking) pickingBuffer.init(screenWidth, screenHeight);
+
+    LatencyTester latencyTester(markerShader, screenWidth, screenHeight, options.latencyFence);
+    if (options.latencyTest) latencyTester.init();
+
     // render loop
     // -----------
     glClearColor(BACKGROUND_COLOR.x, BACKGROUND_COLOR.y, BACKGROUND_COLOR.z, BACKGROUND_COLOR.w);
     float startTime = glfwGetTime();
+    bool gameThread = options.threading == Options::Threading::SPLIT;
+    game->start(nowMicros(), gameThread);
     while (!glfwWindowShouldClose(window))
     {
-        // per-frame time logic
-        // --------------------
-        updateDeltaTime();
+        profiler.beginFrame();
+        if (options.watchShaders) shaderWatcher.reloadChanged();
         // input
         // -----
+        // wait for the frame's start, then take the input as late as possible
+        framePacer.waitForFrame();
+        glfwPollEvents();
         processInput(window);
+        if (!gameThread) game->update(nowMicros());
+        // latest mouse motion right before the view matrix is built: the
+        // snapshot that handled everything just polled, clicks included
+        game->waitForInputs(INPUT_LATCH_TIMEOUT);
+        // so the clicks just handled are picked from this frame
+        processPicks();
+        const Game::Snapshot &snapshot = game->snapshot();
+        camera.setPose(snapshot.cameraPosition, snapshot.yaw, snapshot.pitch);
+        for (int i = 0; i < (int)snapshot.targetCenters.size(); i++)
+        {
+            if (spheres[i].getCenter() != snapshot.targetCenters[i]) spheres[i].move(snapshot.targetCenters[i]);
+        }
+        frameData.update();
 
         // render
         // ------
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        RenderStats::reset();
+        if (useGpuPicking) pickingBuffer.bind(BACKGROUND_COLOR);
+        else glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        {
+            Profiler::Scope scope(profiler, sphereSection);
+            sphereBatch.renderSpheres();
+        }
 
-        for (auto &sphere : spheres)
         {
-            sphere.renderSphere();
+            Profiler::Scope scope(profiler, cubeSection);
+            for (auto &cube : cubes)
+            {
+                cube.renderCube();
+            }
         }
 
-        for (auto &cube : cubes)
+        if (useGpuPicking)
         {
-            cube.renderCube();
+            pickingBuffer.readPicks(snapshot.time);
+            pickingBuffer.present();
         }
 
-        crosshair.renderCrosshair();
+        {
+            Profiler::Scope scope(profiler, crosshairSection);
+            crosshair.renderCrosshair();
+        }
+        if (options.latencyTest)
+        {
+            latencyTester.click(snapshot.lastClickTime);
+            latencyTester.renderMarker();
+        }
 
         // display
         float gameTime = glfwGetTime() - startTime;
         static float fpsLastTime = glfwGetTime();
-        static float fps = 0;
+        static FrameStats::Summary frameSummary = frameStats.window();
         if (glfwGetTime() - fpsLastTime > 1)
         {
             fpsLastTime = glfwGetTime();
-            fps = 1 / deltaTime;
+            frameSummary = frameStats.window();
         }
 
+        int hitTimes = snapshot.hitTimes;
         float acc = 0;
-        if (clickTimes > 0)
+        if (snapshot.clickTimes > 0)
         {
-            acc = (float)hitTimes / clickTimes;
+            acc = (float)hitTimes / snapshot.clickTimes;
         }
 
         float KPM = 0;
@@ -204,19 +353,49 @@ int main()
         {
             KPM = hitTimes / gameTime * 60;
         }
-        printer.renderText(std::format("FPS         : {:.1f}", fps), 10.0f, screenHeight - 40.0, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
-        printer.renderText(std::format("Time        : {:.1f}", gameTime), 10.0f, screenHeight - 60.0, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
-        printer.renderText(std::format("hitTimes    : {:d}", hitTimes), 10.0f, screenHeight - 80.0, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
-        printer.renderText(std::format("Accurancy   : {:.1f}%", acc * 100), 10.0f, screenHeight - 100.0, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
-        printer.renderText(std::format("KPM         : {:.1f}", KPM), 10.0f, screenHeight - 120.0, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
 
-        printer.renderText(std::string("PRESS ESC TO QUIT"), 10.0f, 25, 0.5f, glm::vec3(0.0, 0.0f, 0.0f));
+        double reactionTime = 0; // ms
+        if (hitTimes > 0)
+        {
+            reactionTime = snapshot.reactionTimeTotal / 1000.0 / hitTimes;
+        }
+        printer.setText(fpsText, "FPS         : {:.1f}  1% low {:.1f}  0.1% low {:.1f}", frameSummary.averageFps, frameSummary.low1Fps, frameSummary.low01Fps);
+        printer.setText(timeText, "Time        : {:.1f}", gameTime);
+        printer.setText(hitTimesText, "hitTimes    : {:d}", hitTimes);
+        printer.setText(accuracyText, "Accurancy   : {:.1f}%", acc * 100);
+        printer.setText(KPMText, "KPM         : {:.1f}", KPM);
+        const TargetMetrics::Summary &metrics = snapshot.metrics;
+        printer.setText(reactionText, "Reaction    : {:.3f} ms  p50 {:.0f}  p90 {:.0f}  sd {:.0f}", reactionTime, metrics.reactionP50Ms, metrics.reactionP90Ms, metrics.reactionStdDevMs);
+        printer.setText(flickText, "Flick       : {:.1f} deg  overshoot {:.2f}  on target {:.0f} ms", metrics.flickMeanDeg, metrics.overshootMean, metrics.timeOnTargetMeanMs);
+        printer.setText(frameTimeText, "Frame max   : {:.2f} ms", frameSummary.maxFrameMs);
+        if (options.latencyTest)
+        {
+            const Histogram &latency = latencyTester.getSwapLatency();
+            printer.setText(latencyText, "Latency     : p50 {:.2f} ms  p99 {:.2f} ms", latency.valueAtPercentile(0.5) / 1000.0, latency.valueAtPercentile(0.99) / 1000.0);
+        }
+        profiler.setVisible(showProfiler);
+        profiler.renderOverlay();
+        {
+            Profiler::Scope scope(profiler, textSection);
+            printer.renderTexts();
+        }
+        profiler.endFrame();
 
-        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
+        // glfw: swap buffers, IO events are polled once the next frame is due
         // -------------------------------------------------------------------------------
         glfwSwapBuffers(window);
-        glfwPollEvents();
+        Timestamp presentTime = nowMicros();
+        framePacer.framePresented(presentTime);
+        if (options.latencyTest) latencyTester.framePresented(presentTime);
+        frameStats.addFrame(presentTime);
     }
+    game->stop();
+    recorder.close();
+    shaderWatcher.stop();
+    rawMouse.stop();
+    if (!options.profileOutPath.empty()) profiler.dump(options.profileOutPath);
+    if (!options.statsOutPath.empty()) frameStats.save(options.statsOutPath);
+    if (options.latencyTest) latencyTester.save(options.latencyOutPath);
 
     // optional: de-allocate all resources once they've outlived their purpose:
     // ------------------------------------------------------------------------
@@ -235,21 +414,11 @@ void processInput(GLFWwindow *window)
     // press ESC to quit
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, true);
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) camera.bodyMove(Camera::Movement::FORWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) camera.bodyMove(Camera::Movement::BACKWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) camera.bodyMove(Camera::Movement::LEFT, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) camera.bodyMove(Camera::Movement::RIGHT, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) camera.bodyMove(Camera::Movement::WORLD_UP, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) camera.bodyMove(Camera::Movement::WORLD_DOWN, deltaTime);
-
-
-}
-
-void updateDeltaTime()
-{
-    float currentTime = static_cast<float>(glfwGetTime());
-    deltaTime = currentTime - lastFrameTime;
-    lastFrameTime = currentTime;
+    // toggle on press, not every frame the key is held
+    static bool f3Pressed = false;
+    bool f3Down = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+    if (f3Down && !f3Pressed) showProfiler = !showProfiler;
+    f3Pressed = f3Down;
 }
 
 GLuint loadTexture(const std::string &path)
@@ -302,16 +471,10 @@ GLuint loadTexture(const std::string &path)
 void renderTriangle(const glm::vec3 &vertex_0, const glm::vec3 &vertex_1, const glm::vec3 &vertex_2, const glm::vec3 &color, const Shader &shader)
 {
     shader.use();
-    // camera
-    shader.setMat4("view", camera.getViewMatrix());
-    shader.setMat4("projection", camera.getPersMatrix());
-    shader.setVec3("cameraPos", camera.getPosition());
+    // camera and light come from the FrameData block
 
-    // direct light
-    shader.setVec3("directLight.direction", directLight.direction);
-    shader.setVec3("directLight.ambient", directLight.ambient);
-    shader.setVec3("directLight.diffuse", directLight.diffuse);
-    shader.setVec3("directLight.specular", directLight.specular);
+    // model, the vertices are already in world space
+    shader.setMat4("model", glm::mat4(1.0f));
 
     // material
     shader.setFloat("material.shininess", 64);
@@ -341,6 +504,7 @@ void renderTriangle(const glm::vec3 &vertex_0, const glm::vec3 &vertex_1, const
     glEnableVertexAttribArray(1);
 
     glDrawArrays(GL_TRIANGLES, 0, 3);
+    RenderStats::addDraw(1);
     glUseProgram(NULL);
 
     glDeleteBuffers(1, &VBO);
@@ -378,30 +542,79 @@ void mouseMoveCallback(GLFWwindow *window, double xposIn, double yposIn)
     lastX = xPos;
     lastY = yPos;
 
-    camera.persMove(xOffset, yOffset);
+    InputEvent event{};
+    event.type = InputEvent::Type::MOUSE_MOVE;
+    event.time = nowMicros();
+    event.xOffset = xOffset;
+    event.yOffset = yOffset;
+    game->pushInput(event);
 }
 
 void mouseClickCallback(GLFWwindow *window, int button, int action, int mods)
 {
-    // hit judgement
-    if (button == GLFW_MOUSE_BUTTON_LEFT and action == GLFW_PRESS)
+    InputEvent event{};
+    event.type = InputEvent::Type::MOUSE_BUTTON;
+    event.time = nowMicros();
+    event.button = button;
+    event.action = action;
+    game->pushInput(event);
+};
+
+// movement keys are replayed by the game with their timestamps, like the mouse
+void keyCallback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    static const std::map<int, Camera::Movement> movementKeys = {
+        {GLFW_KEY_W, Camera::Movement::FORWARD},
+        {GLFW_KEY_S, Camera::Movement::BACKWARD},
+        {GLFW_KEY_A, Camera::Movement::LEFT},
+        {GLFW_KEY_D, Camera::Movement::RIGHT},
+        {GLFW_KEY_SPACE, Camera::Movement::WORLD_UP},
+        {GLFW_KEY_LEFT_SHIFT, Camera::Movement::WORLD_DOWN},
+    };
+    auto it = movementKeys.find(key);
+    if (it == movementKeys.end() || action == GLFW_REPEAT) return;
+
+    InputEvent event{};
+    event.type = InputEvent::Type::KEY;
+    event.time = nowMicros();
+    event.button = (int)it->second;
+    event.action = action;
+    game->pushInput(event);
+}
+
+// hand the game's pick requests to the picking buffer and its results back.
+// after the game handled the frame's input, before the target pass is drawn
+void processPicks()
+{
+    if (!useGpuPicking) return;
+    Timestamp clickTime;
+    while (game->popPickRequest(clickTime))
     {
-        clickTimes++;
-        for (auto &sphere : spheres)
-        {
-            glm::vec3 c = sphere.getCenter() - camera.getPosition();
-            glm::vec3 f = camera.getFront();
-            float d = glm::dot(c, f) / glm::length(f);
-            float h_2 = length(c) * length(c) - d * d;
-            float r = sphere.getRadius();
-            if (h_2 < r * r)
-            {
-                hitTimes++;
-                sphere.setGridPos();
-            }
-        }
+        pickingBuffer.requestPick(clickTime);
     }
-};
+    PickingBuffer::Result pick;
+    while (pickingBuffer.poll(pick))
+    {
+        game->pushPickResult(pick);
+    }
+}
+
+// score a recorded session again, through the same game code, without a window
+int replaySession(const std::string &path)
+{
+    SessionReader reader;
+    if (!reader.open(path)) return -1;
+    const SessionLog::Header &header = reader.getHeader();
+    std::cout << "Seed: " << header.seed << std::endl;
+
+    Options options;
+    options.gameMode = (Options::GameMode)header.gameMode;
+    options.hitMode = (Options::HitMode)header.hitMode;
+    Camera replayCamera(CAMERA_POS_DEFAULT, CAMERA_FRONT_DEFAULT);
+    replayCamera.setPose(glm::vec3(header.cameraPosition[0], header.cameraPosition[1], header.cameraPosition[2]), header.cameraYaw, header.cameraPitch);
+    Game replayGame(options, header.seed, replayCamera, triangleShader);
+    return replayGame.replay(reader) ? 0 : 1;
+}
 
 void getMonitorResolution()
 {
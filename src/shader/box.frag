@@ -31,11 +31,18 @@ in vec3 fragPos;
 in vec3 normal;
 in vec2 TexCoords;
 
-uniform vec3 cameraPos;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPos;
+    vec4 lightDirection;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+    vec4 lightSpecular;
+};
 
 uniform Material material;
 uniform PointLight pointLight[4];
-uniform DirectLight directLight;
 
 out vec4 FragColor;
 
@@ -44,8 +51,9 @@ vec3 calcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
 void main()
 {   
+    DirectLight directLight = DirectLight(lightDirection.xyz, lightAmbient.xyz, lightDiffuse.xyz, lightSpecular.xyz);
     vec3 normal_n = normalize(normal);
-    vec3 viewDir = normalize(fragPos - cameraPos);
+    vec3 viewDir = normalize(fragPos - cameraPos.xyz);
     vec3 result = calcDirectLight(directLight, normal_n, viewDir);
     for (int i = 0; i < 4; i++)
     {
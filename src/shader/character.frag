@@ -1,8 +1,8 @@
 #version 330 core
 in vec2 TexCoords;
+in vec3 textColor;
 
 uniform sampler2D text;
-uniform vec3 textColor;
 
 out vec4 color;
 
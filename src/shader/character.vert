@@ -1,12 +1,15 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 1) in vec3 aColor;
 
 uniform mat4 projection;
 
 out vec2 TexCoords;
+out vec3 textColor;
 
 void main()
 {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
+    textColor = aColor;
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+// per instance
+layout (location = 2) in vec3 aCenter;
+layout (location = 3) in float aRadius;
+layout (location = 4) in vec3 aColor;
+
+uniform int objectIdBase; // object id of the first instance
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPos;
+    vec4 lightDirection;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+    vec4 lightSpecular;
+};
+
+out vec3 fragPos;
+out vec3 color;
+out vec3 normal;
+flat out uint fragObjectId;
+
+void main()
+{
+	fragPos = aCenter + aRadius * aPos;
+	gl_Position = projection * view * vec4(fragPos, 1.0);
+	color = aColor;
+	normal = aNormal;
+	fragObjectId = uint(objectIdBase + gl_InstanceID);
+}
\ No newline at end of file
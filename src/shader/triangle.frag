@@ -28,23 +28,34 @@ struct DirectLight {
 in vec3 fragPos;
 in vec3 color;
 in vec3 normal;
+flat in uint fragObjectId;
 
-uniform vec3 cameraPos;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPos;
+    vec4 lightDirection;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+    vec4 lightSpecular;
+};
 
 uniform Material material;
-uniform DirectLight directLight;
 
-out vec4 FragColor;
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out uint objectId; // picking attachment, ignored when there is none
 
 vec3 calcDirectLight(DirectLight light, vec3 normal, vec3 viewDir);
 vec3 calcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
 void main()
 {   
+    DirectLight directLight = DirectLight(lightDirection.xyz, lightAmbient.xyz, lightDiffuse.xyz, lightSpecular.xyz);
     vec3 normal_n = normalize(normal);
-    vec3 viewDir = normalize(fragPos - cameraPos);
+    vec3 viewDir = normalize(fragPos - cameraPos.xyz);
     vec3 result = calcDirectLight(directLight, normal_n, viewDir);
     FragColor = vec4(result, 1.0);
+    objectId = fragObjectId;
 }
 
 vec3 calcDirectLight(DirectLight light, vec3 normal, vec3 viewDir)
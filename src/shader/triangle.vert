@@ -2,18 +2,30 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat4 model;
 uniform vec3 aColor;
+uniform int objectId; // written to the picking attachment, 0 is not pickable
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPos;
+    vec4 lightDirection;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+    vec4 lightSpecular;
+};
 
 out vec3 fragPos;
 out vec3 color;
 out vec3 normal;
+flat out uint fragObjectId;
 
 void main()
 {
-	gl_Position = projection * view * vec4(aPos, 1.0);
-	fragPos = aPos;
+	fragPos = vec3(model * vec4(aPos, 1.0));
+	gl_Position = projection * view * vec4(fragPos, 1.0);
 	color = aColor;
-	normal = aNormal;
+	normal = mat3(model) * aNormal; // model only translates and scales uniformly
+	fragObjectId = uint(objectId);
 }
\ No newline at end of file
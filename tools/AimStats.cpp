@@ -0,0 +1,231 @@
+// Offline analytics over recorded sessions: packs session files (--record)
+// into one archive and computes per player aggregates from the mapped
+// archive on several threads: accuracy, KPM, time to kill percentiles,
+// accuracy over the course of a session and time to kill by flick angle.
+// acc and KPM are computed the way the HUD does.
+//
+// build (from the repository root, one command line):
+//   g++ -std=c++20 -O2 -Iinc -I<glad>/include -I<glm> tools/AimStats.cpp
+//       src/SessionArchive.cpp src/SessionLog.cpp src/Histogram.cpp src/Camera.cpp -pthread -o AimStats
+// run:
+//   ./AimStats pack sessions.a1a [--player NAME] session.bin ... [--player NAME] session.bin ...
+//   ./AimStats stats sessions.a1a [--threads N]
+
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <vector>
+#include <map>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#include "../inc/SessionLog.h"
+#include "../inc/SessionArchive.h"
+#include "../inc/Histogram.h"
+
+namespace {
+    const std::int64_t TIME_BIN = 30000000; // accuracy over time, 30 s
+    const int TIME_BINS = 20;               // the last bin takes everything after 10 min
+    const float FLICK_BIN = 15.0f;          // degrees
+    const int FLICK_BINS = 12;              // 0 ~ 180, acos never goes past the last bin
+
+    struct PlayerStats {
+        int sessions = 0;
+        std::int64_t clicks = 0;
+        std::int64_t hits = 0;
+        double gameTime = 0; // seconds
+        Histogram killTime;
+
+        void add(const PlayerStats &other)
+        {
+            sessions += other.sessions;
+            clicks += other.clicks;
+            hits += other.hits;
+            gameTime += other.gameTime;
+            killTime.add(other.killTime);
+        }
+    };
+
+    // what one worker computed over its share of the sessions
+    struct Partial {
+        std::map<std::string, PlayerStats> players;
+        std::int64_t binClicks[TIME_BINS] = {};
+        std::int64_t binHits[TIME_BINS] = {};
+        Histogram flickKillTime[FLICK_BINS];
+    };
+
+    void usage(const char *program)
+    {
+        std::cout << "usage: " << program << " pack ARCHIVE [--player NAME] SESSION..." << std::endl
+            << "       " << program << " stats ARCHIVE [--threads N]" << std::endl;
+    }
+
+    // a positive number as a whole, a typo keeps the default instead of ending the tool
+    int parseThreads(const char *program, const std::string &value, const int &fallback)
+    {
+        try
+        {
+            std::size_t length = 0;
+            int threads = std::stoi(value, &length);
+            if (length != value.size() || threads < 1) throw std::invalid_argument(value);
+            return threads;
+        }
+        catch (const std::exception &)
+        {
+            std::cout << "Invalid value for --threads: " << value << std::endl;
+            usage(program);
+            return fallback;
+        }
+    }
+
+    int pack(int argc, char **argv)
+    {
+        ArchiveWriter writer;
+        std::string player;
+        for (int i = 3; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+            if (arg == "--player" && i + 1 < argc)
+            {
+                player = argv[++i];
+                continue;
+            }
+            SessionReader reader;
+            if (!reader.open(argv[i])) continue;
+            // sessions without a --player before them are named after their file
+            std::string name = player.empty() ? std::filesystem::path(argv[i]).stem().string() : player;
+            if (!writer.addSession(name, reader)) std::cout << "Skipped " << arg << ", the game never started" << std::endl;
+        }
+        if (!writer.write(argv[2])) return 1;
+        std::cout << "Packed " << writer.sessionCount() << " sessions into " << argv[2] << std::endl;
+        return 0;
+    }
+
+    void scan(const MappedArchive &archive, std::atomic<int> &nextSession, Partial &partial)
+    {
+        for (int i = nextSession++; i < archive.sessionCount(); i = nextSession++)
+        {
+            const SessionArchive::SessionEntry &entry = archive.getSession(i);
+            std::string player(entry.player, std::find(entry.player, entry.player + SessionArchive::PLAYER_NAME_SIZE, 0));
+            PlayerStats &stats = partial.players[player];
+            stats.sessions++;
+            stats.clicks += entry.clickCount;
+            stats.hits += entry.hitCount;
+            stats.gameTime += (entry.endTime - entry.startTime) / 1e6;
+
+            const std::int64_t *clickTimes = archive.column<std::int64_t>(entry.clickTimeOffset);
+            const std::uint8_t *clickHits = archive.column<std::uint8_t>(entry.clickHitOffset);
+            for (std::uint32_t c = 0; c < entry.clickCount; c++)
+            {
+                int bin = (int)std::clamp<std::int64_t>(clickTimes[c] / TIME_BIN, 0, TIME_BINS - 1);
+                partial.binClicks[bin]++;
+                partial.binHits[bin] += clickHits[c];
+            }
+
+            const std::int64_t *killTimes = archive.column<std::int64_t>(entry.killTimeOffset);
+            const float *flicks = archive.column<float>(entry.flickOffset);
+            for (std::uint32_t h = 0; h < entry.hitCount; h++)
+            {
+                stats.killTime.record(killTimes[h]);
+                int bin = std::min((int)(flicks[h] / FLICK_BIN), FLICK_BINS - 1);
+                partial.flickKillTime[bin].record(killTimes[h]);
+            }
+        }
+    }
+
+    int stats(int argc, char **argv)
+    {
+        int threadCount = std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 3; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+            if (arg == "--threads" && i + 1 < argc) threadCount = parseThreads(argv[0], argv[++i], threadCount);
+            else std::cout << "Unknown option: " << arg << std::endl;
+        }
+
+        MappedArchive archive;
+        if (!archive.open(argv[2])) return 1;
+
+        // sessions are handed out one at a time, their lengths vary a lot
+        std::atomic<int> nextSession = 0;
+        std::vector<Partial> partials(threadCount);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; t++)
+        {
+            workers.emplace_back(scan, std::cref(archive), std::ref(nextSession), std::ref(partials[t]));
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        Partial total;
+        for (const auto &partial : partials)
+        {
+            for (const auto &[player, stats] : partial.players)
+            {
+                total.players[player].add(stats);
+            }
+            for (int b = 0; b < TIME_BINS; b++)
+            {
+                total.binClicks[b] += partial.binClicks[b];
+                total.binHits[b] += partial.binHits[b];
+            }
+            for (int b = 0; b < FLICK_BINS; b++)
+            {
+                total.flickKillTime[b].add(partial.flickKillTime[b]);
+            }
+        }
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << archive.sessionCount() << " sessions, " << threadCount << " threads" << std::endl << std::endl;
+        std::cout << std::left << std::setw(20) << "player" << std::right << std::setw(9) << "sessions" << std::setw(9) << "acc %"
+            << std::setw(9) << "KPM" << std::setw(11) << "ttk p50" << std::setw(11) << "ttk p90" << std::setw(11) << "ttk p99" << std::endl;
+        for (const auto &[player, stats] : total.players)
+        {
+            double acc = stats.clicks > 0 ? (double)stats.hits / stats.clicks : 0;
+            double KPM = stats.gameTime > 0 ? stats.hits / stats.gameTime * 60 : 0;
+            std::cout << std::left << std::setw(20) << player << std::right << std::setw(9) << stats.sessions << std::setw(9) << acc * 100
+                << std::setw(9) << KPM
+                << std::setw(8) << stats.killTime.valueAtPercentile(0.5) / 1000.0 << " ms"
+                << std::setw(8) << stats.killTime.valueAtPercentile(0.9) / 1000.0 << " ms"
+                << std::setw(8) << stats.killTime.valueAtPercentile(0.99) / 1000.0 << " ms" << std::endl;
+        }
+
+        std::cout << std::endl << "accuracy over time" << std::endl;
+        for (int b = 0; b < TIME_BINS; b++)
+        {
+            if (total.binClicks[b] == 0) continue;
+            std::cout << std::setw(5) << b * TIME_BIN / 1000000 << (b == TIME_BINS - 1 ? "+ s" : " s  ")
+                << std::setw(9) << 100.0 * total.binHits[b] / total.binClicks[b] << " %" << std::setw(9) << total.binClicks[b] << " clicks" << std::endl;
+        }
+
+        std::cout << std::endl << "time to kill by flick angle" << std::endl;
+        for (int b = 0; b < FLICK_BINS; b++)
+        {
+            const Histogram &killTime = total.flickKillTime[b];
+            if (killTime.count() == 0) continue;
+            std::cout << std::setw(5) << (int)(b * FLICK_BIN) << (b == FLICK_BINS - 1 ? "+ deg" : " deg  ")
+                << std::setw(8) << killTime.valueAtPercentile(0.5) / 1000.0 << " ms p50"
+                << std::setw(8) << killTime.valueAtPercentile(0.9) / 1000.0 << " ms p90" << std::setw(9) << killTime.count() << " hits" << std::endl;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    std::string_view command = argv[1];
+    if (command == "pack") return pack(argc, argv);
+    if (command == "stats") return stats(argc, argv);
+    usage(argv[0]);
+    return 1;
+}
\ No newline at end of file